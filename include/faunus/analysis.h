@@ -1644,7 +1644,10 @@ namespace Faunus
          * calculating all group-to-group interactions (`Energy::g2g`)
          * and, for atomic groups, the internal energy
          * (`Energy::g_internal`). For using the full Hamiltonian,
-         * use the keyword `fullenergy` as shown below.
+         * use the keyword `fullenergy` as shown below. In this case
+         * and if the Hamiltonian supports it (see
+         * `Energybase::scaledEnergyChange()`), the energy change is
+         * obtained without rescaling the particles.
          *
          * JSON input:
          *
@@ -1702,11 +1705,31 @@ namespace Faunus
                         return u;
                     }
 
+                    /* Energy change via `Energybase::scaledEnergyChange()`, if available */
+                    bool scaledEnergy( double Vold, double Vnew, double &du )
+                    {
+                        double s = spc->geo.isotropicScale(dir, cbrt(Vnew / Vold), sqrt(Vnew / Vold));
+                        if ( s == 0 )
+                            return false;
+                        spc->geo_trial = spc->geo;
+                        spc->geo_trial.setVolume(Vnew);
+                        bool ok = pot->scaledEnergyChange(s, du);
+                        spc->geo_trial = spc->geo;
+                        return ok;
+                    }
+
                     void _sample() override
                     {
                         double Vold = spc->geo.getVolume();
                         double Vnew = Vold + dV;
 
+                        double du;
+                        if ( fullenergy && scaledEnergy(Vold, Vnew, du))
+                        {
+                            duexp += exp(-du);
+                            return;
+                        }
+
                         double uold = energy(spc->p);
                         scale(Vold, Vnew);
                         double unew = energy(spc->trial);
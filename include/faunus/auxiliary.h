@@ -1822,6 +1822,9 @@ namespace Faunus
               (std::chrono::steady_clock::now() - tx);
       }
 
+      /** @brief Time spent in between start/stop calls (in `Tunit`) */
+      double elapsed() const { return delta.count(); }
+
       double result() const
       {
           auto now = std::chrono::steady_clock::now();
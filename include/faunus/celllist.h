@@ -0,0 +1,988 @@
+#ifndef FAUNUS_CELLLIST_H
+#define FAUNUS_CELLLIST_H
+
+#ifndef SWIG
+#include <faunus/common.h>
+#include <faunus/point.h>
+#include <faunus/geometry.h>
+#include <faunus/energy.h>
+#include <cstring>
+#include <octree/octree.h>
+#endif
+
+namespace Faunus
+{
+
+  namespace Geometry
+  {
+
+    /**
+     * @brief Cell list for cuboidal containers
+     *
+     * The box is divided into cells with side lengths equal to, or
+     * larger than a given cutoff distance. All particles within the
+     * cutoff of a point are thus found by visiting the (at most) 27 cells
+     * surrounding the point. Binning follows the minimum image convention
+     * so that positions outside the primary box are wrapped. Periodicity
+     * in the z direction can be disabled for slit geometries in which
+     * case out-of-box positions are assigned to the nearest z-layer.
+     *
+     * Example:
+     *
+     * ~~~~
+     * Geometry::CellList cl;
+     * cl.resize( geo.len, 10.0 );    // box lengths, cutoff
+     * cl.update( spc.p );            // bin all particles
+     * for ( int c : cl.neighbours( cl.cell(a) ) )
+     *   for ( int j : cl[c] )
+     *     ...                        // j is a potential neighbour of a
+     * ~~~~
+     */
+    class CellList
+    {
+    private:
+        Eigen::Vector3i n;                       //!< Number of cells in each direction
+        Point len;                               //!< Box side lengths
+        Point cellinv;                           //!< Inverse cell side lengths
+        bool pbcz;                               //!< Periodic in z?
+        std::vector<std::vector<int>> cells;     //!< Particle index in each cell
+        std::vector<std::vector<int>> neighbour; //!< Neighbouring cells of each cell (incl. self)
+        std::vector<int> cellOf;                 //!< Cell index of each particle
+
+        int wrap( int i, int k ) const
+        {
+            if ( k < 2 || pbcz )
+            {
+                i %= n[k];
+                return (i < 0) ? i + n[k] : i;
+            }
+            return std::min(std::max(i, 0), n[k] - 1);
+        }
+
+        int index( int x, int y, int z ) const { return x + n[0] * (y + n[1] * z); }
+
+    public:
+        CellList() : n(1, 1, 1), len(0, 0, 0), cellinv(0, 0, 0), pbcz(true) {}
+
+        /**
+         * @brief Set up cells for box size and cutoff
+         * @param length Box side lengths
+         * @param rc Cutoff distance (angstrom)
+         * @param periodicz Set to false if there is no PBC in z
+         *
+         * This clears all binned particles and `update()` must be called
+         * before the cell list is used.
+         */
+        void resize( const Point &length, double rc, bool periodicz = true )
+        {
+            assert(rc > 0 && "Cell list cutoff must be positive");
+            len = length;
+            pbcz = periodicz;
+            for ( int k = 0; k < 3; k++ )
+            {
+                n[k] = std::max(1, int(std::floor(len[k] / rc)));
+                cellinv[k] = n[k] / len[k];
+            }
+            cells.assign(n.prod(), std::vector<int>());
+            neighbour.resize(n.prod());
+            for ( int x = 0; x < n[0]; x++ )
+                for ( int y = 0; y < n[1]; y++ )
+                    for ( int z = 0; z < n[2]; z++ )
+                    {
+                        auto &v = neighbour[index(x, y, z)];
+                        v.clear();
+                        for ( int dx = -1; dx <= 1; dx++ )
+                            for ( int dy = -1; dy <= 1; dy++ )
+                                for ( int dz = -1; dz <= 1; dz++ )
+                                {
+                                    if ( !pbcz && (z + dz < 0 || z + dz >= n[2]))
+                                        continue;
+                                    v.push_back(index(wrap(x + dx, 0), wrap(y + dy, 1), wrap(z + dz, 2)));
+                                }
+                        // fewer than three cells in a direction gives duplicates
+                        std::sort(v.begin(), v.end());
+                        v.erase(std::unique(v.begin(), v.end()), v.end());
+                    }
+            cellOf.clear();
+        }
+
+        /** @brief Cell index of a position */
+        int cell( const Point &a ) const
+        {
+            return index(
+                wrap(int(std::floor((a.x() + 0.5 * len.x()) * cellinv.x())), 0),
+                wrap(int(std::floor((a.y() + 0.5 * len.y()) * cellinv.y())), 1),
+                wrap(int(std::floor((a.z() + 0.5 * len.z()) * cellinv.z())), 2));
+        }
+
+        /** @brief Bin all particles in vector */
+        template<class Tpvec>
+        void update( const Tpvec &p )
+        {
+            for ( auto &c : cells )
+                c.clear();
+            cellOf.resize(p.size());
+            for ( size_t i = 0; i < p.size(); i++ )
+            {
+                cellOf[i] = cell(p[i]);
+                cells[cellOf[i]].push_back(i);
+            }
+        }
+
+        /** @brief Re-bin particle `i` at new position `a` */
+        void move( int i, const Point &a )
+        {
+            assert(i >= 0 && i < (int) cellOf.size());
+            int c = cell(a);
+            if ( c != cellOf[i] )
+            {
+                auto &v = cells[cellOf[i]];
+                auto it = std::find(v.begin(), v.end(), i);
+                assert(it != v.end() && "Particle not found in cell");
+                *it = v.back();
+                v.pop_back();
+                cells[c].push_back(i);
+                cellOf[i] = c;
+            }
+        }
+
+        /** @brief Index of cells neighbouring cell `c`, including `c` itself */
+        const std::vector<int> &neighbours( int c ) const { return neighbour[c]; }
+
+        /** @brief Particle index in cell `c` */
+        const std::vector<int> &operator[]( int c ) const { return cells[c]; }
+
+        size_t size() const { return cellOf.size(); } //!< Number of binned particles
+
+        int numCells() const { return n.prod(); }     //!< Total number of cells
+
+        /** @brief Call `f(j)` for all particles `j` in cells surrounding `a` */
+        template<class Tfunction>
+        void forEachNeighbour( const Point &a, Tfunction f ) const
+        {
+            for ( int c : neighbour[cell(a)] )
+                for ( int j : cells[c] )
+                    f(j);
+        }
+    };
+
+    /**
+     * @brief Sparse cell list for non-periodic containers
+     *
+     * Same interface as `CellList` but cells are stored in the octree
+     * from `include/octree` so that only occupied cells take up memory
+     * and look-up is O(log n). This is intended for containers such as
+     * `Sphere` and `Cylinder` where a large part of the surrounding box
+     * is empty. Cells are placed in the box given to `resize()` which is
+     * assumed to be centered at the origin, i.e. as returned by
+     * `Geometrybase::inscribe()`. Positions outside the box are assigned
+     * to the nearest cell which, since cells are no smaller than the cutoff,
+     * still finds all neighbours. Periodicity is supported in the z direction
+     * only, as needed for `PeriodicCylinder`.
+     */
+    class OctreeCellList
+    {
+    private:
+        Eigen::Vector3i n;                       //!< Number of cells in each direction
+        Point len;                               //!< Box side lengths
+        Point cellinv;                           //!< Inverse cell side lengths
+        bool pbcz;                               //!< Periodic in z?
+        std::shared_ptr<octree::Octree<int>> tree; //!< Maps cell coordinate to bucket index
+        std::vector<std::vector<int>> buckets;   //!< Particle index in each occupied cell
+        std::vector<Eigen::Vector3i> coord;      //!< Cell coordinate of each bucket
+        std::vector<int> cellOf;                 //!< Bucket index of each particle
+
+        Eigen::Vector3i coordinate( const Point &a ) const
+        {
+            Eigen::Vector3i c;
+            for ( int k = 0; k < 3; k++ )
+            {
+                c[k] = int(std::floor((a[k] + 0.5 * len[k]) * cellinv[k]));
+                if ( k == 2 && pbcz )
+                    c[k] = ((c[k] % n[k]) + n[k]) % n[k];
+                else
+                    c[k] = std::min(std::max(c[k], 0), n[k] - 1);
+            }
+            return c;
+        }
+
+        /* Bucket index of cell coordinate; created if `create` is true */
+        int bucket( const Eigen::Vector3i &c, bool create = false )
+        {
+            int b = tree->at(c.x(), c.y(), c.z());
+            if ( b < 0 && create )
+            {
+                b = buckets.size();
+                buckets.push_back(std::vector<int>());
+                coord.push_back(c);
+                tree->set(c.x(), c.y(), c.z(), b);
+            }
+            return b;
+        }
+
+    public:
+        OctreeCellList() : n(1, 1, 1), len(0, 0, 0), cellinv(0, 0, 0), pbcz(false) {}
+
+        /**
+         * @brief Set up cells for box size and cutoff
+         * @param length Side lengths of box enclosing the container
+         * @param rc Cutoff distance (angstrom)
+         * @param periodicz Set to true if there is PBC in z
+         */
+        void resize( const Point &length, double rc, bool periodicz = false )
+        {
+            assert(rc > 0 && "Cell list cutoff must be positive");
+            len = length;
+            pbcz = periodicz;
+            int size = 1;
+            for ( int k = 0; k < 3; k++ )
+            {
+                n[k] = std::max(1, int(std::floor(len[k] / rc)));
+                cellinv[k] = n[k] / len[k];
+                while ( size < n[k] )
+                    size *= 2; // octree size must be a power of two
+            }
+            tree = std::make_shared<octree::Octree<int>>(size, -1);
+            buckets.clear();
+            coord.clear();
+            cellOf.clear();
+        }
+
+        /** @brief Bin all particles in vector */
+        template<class Tpvec>
+        void update( const Tpvec &p )
+        {
+            for ( auto &b : buckets )
+                b.clear();
+            cellOf.resize(p.size());
+            for ( size_t i = 0; i < p.size(); i++ )
+            {
+                cellOf[i] = bucket(coordinate(p[i]), true);
+                buckets[cellOf[i]].push_back(i);
+            }
+        }
+
+        /** @brief Re-bin particle `i` at new position `a` */
+        void move( int i, const Point &a )
+        {
+            assert(i >= 0 && i < (int) cellOf.size());
+            int b = bucket(coordinate(a), true);
+            if ( b != cellOf[i] )
+            {
+                auto &v = buckets[cellOf[i]];
+                auto it = std::find(v.begin(), v.end(), i);
+                assert(it != v.end() && "Particle not found in cell");
+                *it = v.back();
+                v.pop_back();
+                buckets[b].push_back(i);
+                cellOf[i] = b;
+            }
+        }
+
+        size_t size() const { return cellOf.size(); } //!< Number of binned particles
+
+        int numCells() const { return buckets.size(); } //!< Number of occupied cells
+
+        /** @brief Call `f(j)` for all particles `j` in cells surrounding `a` */
+        template<class Tfunction>
+        void forEachNeighbour( const Point &a, Tfunction f ) const
+        {
+            Eigen::Vector3i c = coordinate(a), d;
+            int zmin = c.z() - 1, zmax = c.z() + 1;
+            if ( pbcz && n.z() < 3 )
+                zmin = 0, zmax = n.z() - 1; // avoid visiting cells twice
+            for ( d.x() = std::max(c.x() - 1, 0); d.x() <= std::min(c.x() + 1, n.x() - 1); d.x()++ )
+                for ( d.y() = std::max(c.y() - 1, 0); d.y() <= std::min(c.y() + 1, n.y() - 1); d.y()++ )
+                    for ( int z = zmin; z <= zmax; z++ )
+                    {
+                        if ( pbcz )
+                            d.z() = (z + n.z()) % n.z();
+                        else if ( z < 0 || z >= n.z())
+                            continue;
+                        else
+                            d.z() = z;
+                        int b = tree->at(d.x(), d.y(), d.z());
+                        if ( b >= 0 )
+                            for ( int j : buckets[b] )
+                                f(j);
+                    }
+        }
+    };
+
+    /**
+     * @brief Cell list type suited for a geometry
+     *
+     * Periodic cuboids use the dense `CellList` while all other containers
+     * use the sparse `OctreeCellList`. `pbcz` is true if the geometry is
+     * periodic in the z direction.
+     */
+    template<class Tgeometry>
+    struct CellListSelector
+    {
+        static const bool dense = std::is_base_of<Cuboid, Tgeometry>::value
+            && !std::is_base_of<CuboidNoPBC, Tgeometry>::value;
+        static const bool pbcz = (dense && !std::is_base_of<Cuboidslit, Tgeometry>::value)
+            || std::is_base_of<PeriodicCylinder, Tgeometry>::value;
+        typedef typename std::conditional<dense, CellList, OctreeCellList>::type type;
+    };
+
+    /**
+     * @brief Cell list of a group that follows the particle vector across moves
+     *
+     * Each call to `sync()` re-bins only the particles listed in a change
+     * log, normally `Space::changeLog()`, since the previous call. This makes
+     * the cell list independent of which moves changed the particles. The
+     * cells are rebuilt if the log epoch, the box, the group range, or the
+     * required cutoff changes. Cells are made large enough to hold on
+     * average at least one particle, so that small cutoffs in large boxes
+     * do not allocate excessive numbers of cells. `forEachNeighbour()`
+     * then reports particle indices in the full particle vector.
+     *
+     * Example:
+     *
+     * ~~~~
+     * Geometry::SyncedCellList<Geometry::Cuboid> cl;
+     * cl.sync( geo.inscribe().len, 10.0, spc.p, g, spc.changeLog(), spc.changeEpoch() );
+     * cl.forEachNeighbour( a, [&](int j) { ... } ); // j is in g
+     * ~~~~
+     */
+    template<class Tgeometry>
+    class SyncedCellList
+    {
+    private:
+        typedef CellListSelector<Tgeometry> Tselector;
+        typename Tselector::type cells;
+        Point len;                               //!< Box lengths at last rebuild
+        double rc;                               //!< Cutoff at last rebuild
+        int first;                               //!< Index of first binned particle
+        int n;                                   //!< Number of binned particles
+        unsigned int epoch;                      //!< Log epoch at last sync
+        size_t cursor;                           //!< Log entries processed at last sync
+        bool built;
+    public:
+        SyncedCellList() : len(0, 0, 0), rc(0), first(0), n(0), epoch(0), cursor(0), built(false) {}
+
+        /**
+         * @brief Bring cells up to date with particles in `g`
+         * @param box Side lengths of box enclosing the container
+         * @param cutoff Minimum cell side length (angstrom)
+         * @param p Particle vector
+         * @param g Range of particles to bin
+         * @param log Index of particles in `p` changed since the log was reset
+         * @param logepoch Counter incremented whenever `log` is reset
+         */
+        template<class Tpvec>
+        void sync( const Point &box, double cutoff, const Tpvec &p, const Group &g,
+                   const std::vector<int> &log, unsigned int logepoch )
+        {
+            int size = g.size();
+            int front = (size > 0) ? g.front() : 0;
+            if ( !built || logepoch != epoch || box != len || cutoff > rc || size != n || front != first )
+            {
+                len = box;
+                rc = cutoff;
+                first = front;
+                n = size;
+                std::vector<Point> pos(p.begin() + first, p.begin() + first + n);
+                cells.resize(len, std::max(rc, std::cbrt(len.prod() / std::max(n, 1))), Tselector::pbcz);
+                cells.update(pos);
+                built = true;
+            }
+            else
+                for ( size_t k = cursor; k < log.size(); k++ )
+                    if ( log[k] >= first && log[k] < first + n )
+                        cells.move(log[k] - first, p[log[k]]);
+            epoch = logepoch;
+            cursor = log.size();
+        }
+
+        /** @brief Call `f(j)` for binned particles `j` in cells surrounding `a` */
+        template<class Tfunction>
+        void forEachNeighbour( const Point &a, Tfunction f ) const
+        {
+            cells.forEachNeighbour(a, [&]( int k ) { f(first + k); });
+        }
+    };
+
+    /**
+     * @brief Largest radius of a group of particles that follows the particle vector across moves
+     *
+     * As `SyncedCellList`, the value is updated from a change log and all
+     * particles are scanned only if the log epoch or the group changes.
+     * Radii that decrease are not accounted for until the next scan so the
+     * value is an upper bound.
+     */
+    class SyncedMaxRadius
+    {
+    private:
+        double rmax;
+        int front, back;                         //!< Range scanned at last rebuild
+        unsigned int epoch;                      //!< Log epoch at last call
+        size_t cursor;                           //!< Log entries processed at last call
+        bool built;
+    public:
+        SyncedMaxRadius() : rmax(0), front(0), back(-1), epoch(0), cursor(0), built(false) {}
+
+        /** @brief Largest radius in `g`; see `SyncedCellList::sync()` for arguments */
+        template<class Tpvec>
+        double operator()( const Tpvec &p, const Group &g, const std::vector<int> &log, unsigned int logepoch )
+        {
+            if ( !built || logepoch != epoch || g.front() != front || g.back() != back )
+            {
+                front = g.front();
+                back = g.back();
+                rmax = 0;
+                for ( auto i : g )
+                    rmax = std::max(rmax, p[i].radius);
+                built = true;
+            }
+            else
+                for ( size_t k = cursor; k < log.size(); k++ )
+                    if ( g.find(log[k]))
+                        rmax = std::max(rmax, p[log[k]].radius);
+            epoch = logepoch;
+            cursor = log.size();
+            return rmax;
+        }
+    };
+
+  }//namespace Geometry
+
+  namespace Energy
+  {
+
+    /**
+     * @brief Cutoff distance of a short ranged pair potential
+     *
+     * Same as `pairRange()` but throws if the potential is not truncated.
+     */
+    template<class Tpairpot>
+    double pairCutoff( Tmjson &j, const Tpairpot &pairpot )
+    {
+        double rc = pairRange(j, pairpot);
+        if ( std::isinf(rc))
+            throw std::runtime_error("Neighbour search requires a finite pair potential cutoff");
+        return rc;
+    }
+
+    /**
+     * @brief Non-bonded energy using cell lists
+     *
+     * Energy class for short-ranged pair potentials where particle neighbours
+     * are found using a cell list so that single particle energies scale as
+     * O(1) rather than O(N). Periodic cuboids use `Geometry::CellList` while
+     * other containers such as `Sphere` and `Cylinder` use the sparse
+     * `Geometry::OctreeCellList`, see `Geometry::CellListSelector`.
+     * Only cells within the cutoff of a particle are
+     * visited and the pair potential *must* be zero beyond this distance,
+     * for example using `Potential::CutShift` or `Potential::LennardJonesTrunkShift`.
+     *
+     * The cutoff is taken as the largest pair cutoff reported by the pair
+     * potential (`PairPotentialBase::rcut2`) or, if larger, the value of
+     * `cutoff` in the JSON section `energy/nonbonded`.
+     *
+     * Two cell lists are kept; one for `Space::p` and one for `Space::trial`.
+     * The trial list is updated in `updateChange()` and the accepted list
+     * is synchronised in `update()`. Moves must therefore fill in their
+     * `Space::Change` object. Changes in geometry, or insertion and
+     * deletion of particles, cause a complete re-binning of the affected
+     * list. The trial list follows `Space::geo_trial` and the accepted list
+     * `Space::geo` so that a volume move re-bins each list once.
+     * If a particle vector other than `p` or `trial` is given, the
+     * energy is evaluated without cell lists.
+     */
+    template<class Tspace, class Tpairpot>
+    class NonbondedCellList : public Nonbonded<Tspace, Tpairpot>
+    {
+    private:
+        typedef Nonbonded<Tspace, Tpairpot> base;
+        typedef typename base::Tpvec Tpvec;
+        typedef typename Tspace::GeometryType Tgeometry;
+        using base::spc;
+        using base::geo;
+        using base::pairpot;
+        typedef Geometry::CellListSelector<Tgeometry> Tselector;
+        typedef typename Tselector::type Tcells;
+
+        double rc;                          // cutoff distance
+        Tcells cells;                       // cells for `spc->p`
+        Tcells cellsTrial;                  // cells for `spc->trial`
+        Point box;                          // box of the bound geometry
+        Point len, lenTrial;                // box binned in `cells` and `cellsTrial`
+        std::vector<int> moved;             // particles touched by current trial move
+        bool rebin;                         // complete re-binning needed in next update
+        bool rebinTrial;                    // trial list must be re-binned before use
+        double cellsize;                    // average number of particles per cell
+
+        string _info() override
+        {
+            using namespace textio;
+            std::ostringstream o;
+            o << base::_info()
+              << pad(SUB, 25, "Cell list cutoff") << rc << _angstrom << endl
+              << pad(SUB, 25, "Number of cells") << cells.numCells() << endl;
+            return o.str();
+        }
+
+        /* Cell list matching particle vector; `nullptr` if none */
+        Tcells *select( const Tpvec &p )
+        {
+            if ( &p == &spc->p )
+            {
+                sync(false);
+                return &cells;
+            }
+            if ( base::isTrial(p))
+            {
+                syncTrial(rebinTrial);
+                return &cellsTrial;
+            }
+            return nullptr;
+        }
+
+        /* Use cell list only if it visits fewer particles than a plain loop */
+        bool worthIt( const Group &g ) const { return g.size() > 27 * cellsize; }
+
+        /* True if list `cl` binned in box `binned` is out of date for `p` and the bound geometry */
+        bool stale( const Tcells &cl, const Point &binned, const Tpvec &p ) const
+        {
+            return cl.size() != p.size() || binned != box;
+        }
+
+        /* Re-bin `spc->p` if forced or if the box or particle count changed */
+        void sync( bool force )
+        {
+            if ( force || stale(cells, len, spc->p))
+            {
+                len = box;
+                cells.resize(len, rc, Tselector::pbcz);
+                cells.update(spc->p);
+                cellsize = double(spc->p.size()) / cells.numCells();
+            }
+        }
+
+        /* Re-bin `spc->trial` if forced or if the box or particle count changed */
+        void syncTrial( bool force )
+        {
+            if ( force || stale(cellsTrial, lenTrial, spc->trial))
+            {
+                lenTrial = box;
+                cellsTrial.resize(lenTrial, rc, Tselector::pbcz);
+                cellsTrial.update(spc->trial);
+            }
+            rebinTrial = false;
+        }
+
+    public:
+        NonbondedCellList( Tmjson &j, const string &sec = "nonbonded" ) : base(j, sec), box(0, 0, 0), len(0, 0, 0), lenTrial(0, 0, 0),
+                                                                           rebin(false), rebinTrial(true), cellsize(0)
+        {
+            rc = pairCutoff(j["energy"][sec], pairpot);
+            base::name += " (cell list)";
+        }
+
+        auto tuple() -> decltype(std::make_tuple(this))
+        {
+            return std::make_tuple(this);
+        }
+
+        /**
+         * Called by `setSpace()` as well as for trial geometries. Only the
+         * list belonging to `g` is re-binned, and only if its box changed;
+         * the accepted list is left for `update()` if a re-binning is pending.
+         */
+        void setGeometry( Tgeometry &g ) override
+        {
+            base::setGeometry(g);
+            box = geo.inscribe().len;
+            if ( spc == nullptr )
+                return;
+            if ( &g == &spc->geo_trial )
+                syncTrial(rebinTrial);
+            else if ( !rebin )
+            {
+                sync(false);
+                syncTrial(rebinTrial);
+            }
+        }
+
+        /* Lists are rebuilt on demand if out of sync; not safe in parallel */
+        bool concurrent() const override
+        {
+            return base::concurrent() && !rebinTrial && !stale(cells, len, spc->p)
+                && !stale(cellsTrial, lenTrial, spc->trial);
+        }
+
+        /** @brief Re-bin moved particles in the trial cell list */
+        double updateChange( const typename Tspace::Change &c ) override
+        {
+            moved.clear();
+            if ( c.empty() || c.geometryChange || !c.inGroup.empty() || !c.rmGroup.empty())
+            {
+                rebinTrial = rebin = true;
+                return 0;
+            }
+            for ( auto &m : c.mvGroup )
+                if ( m.second.empty())
+                    for ( auto i : *spc->groupList().at(m.first))
+                        moved.push_back(i);
+                else
+                    moved.insert(moved.end(), m.second.begin(), m.second.end());
+            if ( !rebinTrial && cellsTrial.size() == spc->trial.size())
+                for ( auto i : moved )
+                    cellsTrial.move(i, spc->trial[i]);
+            return 0;
+        }
+
+        /**
+         * @brief Synchronise accepted cell list, or revert trial cell list
+         *
+         * After a re-binning trial, only the list that no longer matches
+         * `Space::p` is rebuilt: the accepted list on acceptance (the trial
+         * list already holds the new configuration) and the trial list on
+         * rejection.
+         */
+        double update( bool acc ) override
+        {
+            if ( rebin )
+            {
+                sync(acc);
+                syncTrial(!acc || rebinTrial);
+                rebin = false;
+            }
+            else if ( stale(cells, len, spc->p) || rebinTrial || stale(cellsTrial, lenTrial, spc->trial))
+            {
+                sync(true);
+                syncTrial(true);
+            }
+            else
+            {
+                for ( auto i : moved )
+                    if ( acc )
+                        cells.move(i, spc->trial[i]);
+                    else
+                        cellsTrial.move(i, spc->p[i]);
+            }
+            moved.clear();
+            return 0;
+        }
+
+        /* Interactions are truncated at the cell range */
+        bool scaledEnergyChange( double, double & ) override { return false; }
+
+        double i2all( Tpvec &p, int i ) override
+        {
+            assert(i >= 0 && i < int(p.size()) && "index i outside particle vector");
+            auto cl = select(p);
+            if ( cl == nullptr )
+                return base::i2all(p, i);
+            double u = 0;
+            const auto &a = p[i];
+            cl->forEachNeighbour(a, [&]( int j ) {
+                if ( j != i )
+                    u += pairpot(a, p[j], geo.sqdist(a, p[j]));
+            });
+            return u;
+        }
+
+        double i2g( const Tpvec &p, Group &g, int i ) override
+        {
+            auto cl = select(p);
+            if ( cl == nullptr || !worthIt(g))
+                return base::i2g(p, g, i);
+            double u = 0;
+            const auto &a = p[i];
+            cl->forEachNeighbour(a, [&]( int j ) {
+                if ( j != i && g.find(j))
+                    u += pairpot(a, p[j], geo.sqdist(a, p[j]));
+            });
+            return u;
+        }
+
+        /**
+         * The smaller group is looped over and neighbours belonging to
+         * the larger group (but not to the smaller) are included. This
+         * also covers the case where one group is a subset of the other.
+         */
+        double g2g( const Tpvec &p, Group &g1, Group &g2 ) override
+        {
+            if ( g1.empty() || g2.empty())
+                return 0;
+            Group &small = (g1.size() < g2.size()) ? g1 : g2;
+            Group &large = (g1.size() < g2.size()) ? g2 : g1;
+            auto cl = select(p);
+            if ( cl == nullptr || !worthIt(large))
+                return base::g2g(p, g1, g2);
+            double u = 0;
+            for ( auto i : small )
+            {
+                const auto &a = p[i];
+                cl->forEachNeighbour(a, [&]( int j ) {
+                    if ( large.find(j) && !small.find(j))
+                        u += pairpot(a, p[j], geo.sqdist(a, p[j]));
+                });
+            }
+            return u;
+        }
+
+        double g_internal( const Tpvec &p, Group &g ) override
+        {
+            auto cl = select(p);
+            if ( cl == nullptr || !worthIt(g))
+                return base::g_internal(p, g);
+            double u = 0;
+            for ( auto i : g )
+            {
+                const auto &a = p[i];
+                cl->forEachNeighbour(a, [&]( int j ) {
+                    if ( j > i && g.find(j))
+                        u += pairpot(a, p[j], geo.sqdist(a, p[j]));
+                });
+            }
+            return u + pairpot.internal(p, g);
+        }
+    };
+
+    /**
+     * @brief Non-bonded energy using Verlet neighbour lists
+     *
+     * For each particle a list of neighbours within the cutoff plus a skin
+     * distance is stored in a single contiguous array. As long as no particle
+     * has moved more than half the skin since the lists were built, all pairs
+     * within the cutoff are found in the lists and `i2all`, `i2g`, `g2g` and
+     * `g_internal` loop over neighbours only. The pair potential must be zero
+     * beyond the cutoff which is found as described in `pairCutoff()`.
+     *
+     * Displacements are tracked via `Space::Change` in `updateChange()`; an
+     * empty change is taken to mean unknown displacements. If a
+     * trial move brings a particle further than half the skin from where
+     * the lists were built, the trial energy is evaluated with plain loops
+     * and the lists are rebuilt in `update()` if the move is accepted. Lists are
+     * always valid for `Space::p` and are built in O(N) using the cell list
+     * given by `Geometry::CellListSelector`.
+     *
+     * Keyword  | Description
+     * :------- | :-------------------------------------------
+     * `cutoff` | Pair potential cutoff (angstrom)
+     * `skin`   | Skin distance added to cutoff (default: 1 angstrom)
+     */
+    template<class Tspace, class Tpairpot>
+    class NonbondedVerlet : public Nonbonded<Tspace, Tpairpot>
+    {
+    private:
+        typedef Nonbonded<Tspace, Tpairpot> base;
+        typedef typename base::Tpvec Tpvec;
+        typedef typename Tspace::GeometryType Tgeometry;
+        using base::spc;
+        using base::geo;
+        using base::pairpot;
+
+        double rc, skin;
+        std::vector<int> first;         // neighbours of i are nbr[first[i]] to nbr[first[i+1]-1]
+        std::vector<int> nbr;           // neighbour index of all particles
+        std::vector<Point> ref;         // positions at last build
+        bool trialValid;                // lists valid for `spc->trial`?
+        unsigned long int cntBuild;     // number of list builds
+
+        string _info() override
+        {
+            using namespace textio;
+            std::ostringstream o;
+            o << base::_info()
+              << pad(SUB, 25, "Verlet list cutoff") << rc << "+" << skin << _angstrom << endl
+              << pad(SUB, 25, "Number of list builds") << cntBuild << endl;
+            if ( !ref.empty())
+                o << pad(SUB, 25, "Average neighbours") << double(nbr.size()) / ref.size() << endl;
+            return o.str();
+        }
+
+        /* Pairs within `rv` found via cell list */
+        void findPairs( double rv, std::vector<std::vector<int>> &list )
+        {
+            typedef Geometry::CellListSelector<Tgeometry> Tselector;
+            typename Tselector::type cells;
+            cells.resize(geo.inscribe().len, rv, Tselector::pbcz);
+            cells.update(spc->p);
+            double rv2 = rv * rv;
+            for ( size_t i = 0; i < spc->p.size(); i++ )
+                cells.forEachNeighbour(spc->p[i], [&]( int j ) {
+                    if ( j > int(i) && geo.sqdist(spc->p[i], spc->p[j]) < rv2 )
+                    {
+                        list[i].push_back(j);
+                        list[j].push_back(i);
+                    }
+                });
+        }
+
+        void rebuild()
+        {
+            size_t n = spc->p.size();
+            std::vector<std::vector<int>> list(n);
+            findPairs(rc + skin, list);
+            first.resize(n + 1);
+            nbr.clear();
+            ref.resize(n);
+            for ( size_t i = 0; i < n; i++ )
+            {
+                first[i] = nbr.size();
+                nbr.insert(nbr.end(), list[i].begin(), list[i].end());
+                ref[i] = spc->p[i];
+            }
+            first[n] = nbr.size();
+            trialValid = true;
+            cntBuild++;
+        }
+
+        /* True if lists can be used for particle vector */
+        bool valid( const Tpvec &p )
+        {
+            if ( ref.size() != spc->p.size())
+                rebuild();
+            if ( p.size() != ref.size())
+                return false;
+            if ( &base::getGeometry() != &spc->geo )
+                return false; // lists refer to the current geometry
+            if ( &p == &spc->p )
+                return true;
+            return base::isTrial(p) && trialValid;
+        }
+
+        /* Call `f(j)` for all neighbours of particle `i` */
+        template<class Tfunction>
+        void forEachNeighbour( int i, Tfunction f ) const
+        {
+            for ( int k = first[i], end = first[i + 1]; k < end; ++k )
+                f(nbr[k]);
+        }
+
+    public:
+        NonbondedVerlet( Tmjson &j, const string &sec = "nonbonded" ) : base(j, sec), trialValid(false), cntBuild(0)
+        {
+            rc = pairCutoff(j["energy"][sec], pairpot);
+            skin = j["energy"][sec].value("skin", 1.0);
+            if ( skin < 0 )
+                throw std::runtime_error("Verlet list skin must be positive");
+            base::name += " (Verlet list)";
+        }
+
+        auto tuple() -> decltype(std::make_tuple(this))
+        {
+            return std::make_tuple(this);
+        }
+
+        void setSpace( Tspace &s ) override
+        {
+            base::setSpace(s);
+            rebuild();
+        }
+
+        bool concurrent() const override { return base::concurrent() && ref.size() == spc->p.size(); }
+
+        /** @brief Check if moved trial particles are still covered by the lists */
+        double updateChange( const typename Tspace::Change &c ) override
+        {
+            if ( c.empty() || c.geometryChange || !c.inGroup.empty() || !c.rmGroup.empty()
+                || ref.size() != spc->trial.size())
+            { // unknown displacements are treated as a rebuild
+                trialValid = false;
+                return 0;
+            }
+            double maxdisp2 = 0.25 * skin * skin;
+            auto check = [&]( int i ) {
+                if ( geo.sqdist(spc->trial[i], ref[i]) > maxdisp2 )
+                    trialValid = false;
+            };
+            for ( auto &m : c.mvGroup )
+                if ( m.second.empty())
+                    for ( auto i : *spc->groupList().at(m.first))
+                        check(i);
+                else
+                    for ( auto i : m.second )
+                        check(i);
+            return 0;
+        }
+
+        /** @brief Rebuild lists if an accepted move invalidated them */
+        double update( bool acc ) override
+        {
+            if ( (acc && !trialValid) || ref.size() != spc->p.size())
+                rebuild();
+#ifndef NDEBUG
+            double maxdisp2 = 0.25 * skin * skin;
+            for ( size_t i = 0; i < ref.size(); i++ )
+                assert(geo.sqdist(spc->p[i], ref[i]) <= maxdisp2 && "Verlet skin exceeded - displacement missing from Space::Change?");
+#endif
+            trialValid = true;
+            return 0;
+        }
+
+        /* Interactions are truncated at the list range */
+        bool scaledEnergyChange( double, double & ) override { return false; }
+
+        double i2all( Tpvec &p, int i ) override
+        {
+            assert(i >= 0 && i < int(p.size()) && "index i outside particle vector");
+            if ( !valid(p))
+                return base::i2all(p, i);
+            double u = 0;
+            const auto &a = p[i];
+            forEachNeighbour(i, [&]( int j ) {
+                u += pairpot(a, p[j], geo.sqdist(a, p[j]));
+            });
+            return u;
+        }
+
+        double i2g( const Tpvec &p, Group &g, int i ) override
+        {
+            if ( !valid(p))
+                return base::i2g(p, g, i);
+            double u = 0;
+            const auto &a = p[i];
+            forEachNeighbour(i, [&]( int j ) {
+                if ( g.find(j))
+                    u += pairpot(a, p[j], geo.sqdist(a, p[j]));
+            });
+            return u;
+        }
+
+        /** Neighbours of the smaller group that belong to the larger group (but not the smaller) */
+        double g2g( const Tpvec &p, Group &g1, Group &g2 ) override
+        {
+            if ( g1.empty() || g2.empty())
+                return 0;
+            if ( !valid(p))
+                return base::g2g(p, g1, g2);
+            Group &small = (g1.size() < g2.size()) ? g1 : g2;
+            Group &large = (g1.size() < g2.size()) ? g2 : g1;
+            double u = 0;
+            for ( auto i : small )
+            {
+                const auto &a = p[i];
+                forEachNeighbour(i, [&]( int j ) {
+                    if ( large.find(j) && !small.find(j))
+                        u += pairpot(a, p[j], geo.sqdist(a, p[j]));
+                });
+            }
+            return u;
+        }
+
+        double g_internal( const Tpvec &p, Group &g ) override
+        {
+            if ( !valid(p))
+                return base::g_internal(p, g);
+            double u = 0;
+            for ( auto i : g )
+            {
+                const auto &a = p[i];
+                forEachNeighbour(i, [&]( int j ) {
+                    if ( j > i && g.find(j))
+                        u += pairpot(a, p[j], geo.sqdist(a, p[j]));
+                });
+            }
+            return u + pairpot.internal(p, g);
+        }
+    };
+
+  }//namespace Energy
+}//namespace Faunus
+#endif
@@ -74,6 +74,12 @@ namespace Faunus
         
         bool isGeometryTrial(typename Tspace::GeometryType &g) const { return (&g==&spc->geo_trial); }
 
+        /** @brief True if only the listed particles of an atomic group have moved */
+        bool isAtomResolved( const std::pair<const int, vector<int>> &m ) const
+        {
+            return !m.second.empty() && spc->groupList().at(m.first)->isAtomic();
+        }
+
     public:
         string name;  //!< Short informative name
 
@@ -97,6 +103,15 @@ namespace Faunus
             return *spc;
         }
         
+        /**
+         * @brief Bind geometry used for energy evaluation
+         *
+         * This is normally `Space::geo`, but during trial evaluation of
+         * geometry changes `Space::geo_trial` is bound, see
+         * `Energy::evaluateTrialGeometry()`. Unlike `setSpace()` this
+         * should only rebind geometry dependent data and energy terms
+         * should not read `Space::geo` directly.
+         */
         virtual void setGeometry(typename Tspace::GeometryType &g)
         {
             geo=&g;
@@ -163,49 +178,154 @@ namespace Faunus
         /** @brief Update energy function due to Change */
         virtual double updateChange( const typename Tspace::Change &c ) { return 0; }
 
+        /**
+         * @brief Energy change if the trial geometry scales all distances
+         * @param s Linear scaling factor of all particle-particle distances
+         * @param du Energy change (kT) is returned here
+         * @return False if not available, in which case the energy must be recalculated
+         *
+         * Used by volume moves to avoid a full energy evaluation at the
+         * old and new volume. The trial geometry is `Space::geo_trial`.
+         */
+        virtual bool scaledEnergyChange( double s, double &du ) { return false; }
+
         virtual void field( const Tpvec &, Eigen::MatrixXd & ) //!< Calculate electric field on all particles
         {}
 
+        /**
+         * @brief True if `g2g()`, `i2g()` and `i2i()` may be called concurrently
+         *
+         * With OpenMP enabled, the group pair loops in `systemEnergy()` and
+         * `g2All()` are run in parallel if this is true. Energies whose pair
+         * functions modify internal state must return false.
+         */
+        virtual bool concurrent() const { return true; }
+
+        /**
+         * @brief True if all interactions are between pairs of particles
+         *
+         * The energy of a pair must depend only on the two particles, and
+         * `g2g()` and `g_internal()` must be sums over pairs as given by `i2g()`.
+         * The energy change of moving part of a group can then be found
+         * from `i2g()` of the moved particles alone, see `segmentEnergy()`.
+         * Energies with cutoffs or properties based on whole groups must
+         * return false.
+         */
+        virtual bool pairwise() const { return true; }
+
+        /**
+         * @brief Distance beyond which particles do not interact
+         *
+         * Moves that evaluate trial moves of distant particles independently,
+         * see `Move::AtomicTranslation`, require a finite range. Energies
+         * without particle-particle interactions return zero.
+         */
+        virtual double cutoff() const { return pc::infty; }
+
+        /** @brief Parameters and results as JSON object, e.g. for `Move::Propagator::json()` */
+        virtual Tmjson json() const { return Tmjson(); }
+
+        /**
+         * @brief Total energy of all groups
+         *
+         * Group pairs are distributed dynamically over threads and the
+         * partial sums reduced in fixed order so that the result does not
+         * depend on the number of threads.
+         */
         virtual double systemEnergy( const Tpvec &p )
         {
-            double u_pair = 0.0;
+            auto &g = spc->groupList();
             double u = external(p);
-            for ( auto g : spc->groupList())
-                if (!g->empty())
-                    u += g_external(p, *g) + g_internal(p, *g);
-            for ( auto i = spc->groupList().begin(); i != spc->groupList().end(); ++i )
-                for ( auto j = i; ++j != spc->groupList().end(); )
-                    u_pair += g2g(p, **i, **j);
-            return u + u_pair;
+            for ( auto gi : g )
+                if (!gi->empty())
+                    u += g_external(p, *gi) + g_internal(p, *gi);
+
+            int n = g.size();
+            std::vector<double> du(n, 0.0); // group i with all groups j>i
+#pragma omp parallel for schedule (dynamic) if (n > 2 && concurrent())
+            for ( int i = 0; i < n - 1; i++ )
+                for ( int j = i + 1; j < n; j++ )
+                    du[i] += g2g(p, *g[i], *g[j]);
+            for ( auto x : du )
+                u += x;
+            return u;
         }
 
+        /**
+         * @brief Energy of moved groups with all other groups
+         * @param p Particle vector
+         * @param mg Moved groups and particles, see `Space::Change::mvGroup`
+         *
+         * If an atomic group lists the moved particles, only these are
+         * considered and their interactions are found using `i2g()`.
+         * Otherwise the whole group has moved and `g2g()` is used.
+         * Moved and static group pairs are evaluated in parallel as in
+         * `systemEnergy()`.
+         */
         virtual double g2All(const Tpvec & p, const std::map<int, vector<int>>& mg)
         {
-            double du = 0;
             auto &g = spc->groupList();
-
-            for ( auto &m : mg ) // loop over all moved groups
+            std::vector<const std::pair<const int, vector<int>>*> moved;
+            for ( auto &m : mg )
+                moved.push_back(&m);
+
+            // Calculate energy moved <-> static groups
+            int n = g.size(), ntask = moved.size() * n;
+            std::vector<double> dut(ntask, 0.0); // one entry per (moved, static) group pair
+            bool reject = false;
+#pragma omp parallel for schedule (dynamic) if (ntask > 2 && concurrent())
+            for ( int t = 0; t < ntask; t++ )
             {
-                size_t i = size_t(m.first);                       // index of moved group
-
-                // Calculate energy moved <-> static groups
-                for ( size_t j = 0; j < g.size(); j++ ) {           // loop over through all groups
-                    if ( mg.count(j) == 0 ) {                // If group j is not in mvGroup
-                        du += g2g(p, *g[i], *g[j]);           // moved group<->static groups
-                        if ( du == pc::infty )
-                            return pc::infty;   // early rejection
-                    }
+                bool stop;
+#pragma omp atomic read
+                stop = reject;
+                int j = t % n;
+                auto &m = *moved[t / n];
+                if ( stop || mg.count(j) != 0 ) // group j is in mvGroup
+                    continue;
+                if ( isAtomResolved(m) )
+                    for ( auto k : m.second )
+                        dut[t] += i2g(p, *g[j], k);         // moved atoms<->static groups
+                else
+                    dut[t] = g2g(p, *g[m.first], *g[j]);  // moved group<->static groups
+                if ( dut[t] == pc::infty )
+                {
+#pragma omp atomic write
+                    reject = true;
                 }
             }
+            if ( reject )
+                return pc::infty;   // early rejection
+
+            double du = 0;
+            for ( auto x : dut )
+                du += x;
+            if ( du == pc::infty )
+                return pc::infty;
 
             // Calculate energy moved <-> moved
             for ( auto i = mg.begin(); i != mg.end(); i++ )
             {
                 for ( auto j = i; j != mg.end(); j++ ) // MIKAEL should it not be j = (++mg.begin()) instead of j = i, why include interaction with self
                 {
-                    auto _i = i->first;
-                    auto _j = j->first;
-                    du += g2g(p, *g[_i], *g[_j]);
+                    Group &gi = *g[i->first];
+                    Group &gj = *g[j->first];
+                    if ( isAtomResolved(*i) && isAtomResolved(*j) )
+                    {
+                        if ( i == j )
+                            continue;   // atomic self interaction is handled by `energyChangeConfiguration()`
+                        for ( auto k : i->second )
+                            du += i2g(p, gj, k);
+                        for ( auto l : j->second )
+                            du += i2g(p, gi, l);
+                        if ( du == pc::infty )
+                            return pc::infty;   // early rejection
+                        for ( auto k : i->second )      // moved<->moved pairs were counted twice
+                            for ( auto l : j->second )
+                                du -= i2i(p, k, l);
+                    }
+                    else
+                        du += g2g(p, gi, gj);
                     if ( du == pc::infty )
                         return pc::infty;   // early rejection
                 }
@@ -307,6 +427,10 @@ namespace Faunus
             }
         }
 
+        bool concurrent() const override { return false; } // `groupMap` is modified on lookup
+
+        bool pairwise() const override { return false; } // only `g2g()` updates the matrix
+
         double g1g2( const Tpvec &p1, Group &g1, const Tpvec &p2, Group &g2 )
         {
             if(isTrial(p1) || isTrial(p2)) {
@@ -729,6 +853,25 @@ namespace Faunus
             return first.updateChange(c) + second.updateChange(c);
         }
 
+        bool scaledEnergyChange( double s, double &du ) override
+        {
+            double du1, du2;
+            if ( first.scaledEnergyChange(s, du1) && second.scaledEnergyChange(s, du2))
+            {
+                du = du1 + du2;
+                return true;
+            }
+            return false;
+        }
+
+        bool concurrent() const override { return first.concurrent() && second.concurrent(); }
+
+        bool pairwise() const override { return first.pairwise() && second.pairwise(); }
+
+        double cutoff() const override { return std::max(first.cutoff(), second.cutoff()); }
+
+        Tmjson json() const override { return merge(first.json(), second.json()); }
+
         double v2v( const Tpvec &p1, const Tpvec &p2 ) override { return first.v2v(p1, p2) + second.v2v(p1, p2); }
 
         void field( const Tpvec &p, Eigen::MatrixXd &E ) override
@@ -748,6 +891,189 @@ namespace Faunus
         std::enable_if<std::is_base_of<Energybase<typename T1::SpaceType>, T2>::value>::type>
     CombinedEnergy<T1, T2> &operator+( const T1 &u1, const T2 &u2 ) { return *(new CombinedEnergy<T1, T2>(u1, u2)); }
 
+    /**
+     * @brief Compile-time composed Hamiltonian
+     *
+     * Sums a fixed list of concrete energy terms, stored by value. Terms are
+     * called by qualified name so that, apart from the entry call through
+     * `Energybase`, no virtual dispatch takes place and all terms can be
+     * inlined. Pair potentials that should share one pair loop (and hence
+     * one distance calculation) are best given as a single `Nonbonded` term
+     * over `Potential::PairPotentialSum`:
+     *
+     *     using namespace Potential;
+     *     typedef Nonbonded<Tspace, PairPotentialSum<CoulombGalore, LennardJonesLB>::type> Tnonbonded;
+     *     StaticHamiltonian<Tspace, Tnonbonded, ExternalPressure<Tspace>> pot(in);
+     *     pot.setSpace(spc);
+     *
+     * The `Tmjson` constructor requires all terms to be constructible from
+     * the json object; otherwise pass constructed terms.
+     */
+    template<class Tspace, class... Tterms>
+    class StaticHamiltonian;
+
+    template<class Tspace>
+    class StaticHamiltonian<Tspace> final : public Energybase<Tspace>
+    {
+    private:
+        string _info() override { return string(); }
+
+    public:
+        StaticHamiltonian() {}
+
+        StaticHamiltonian( Tmjson & ) {}
+
+        std::tuple<> tuple() { return std::tuple<>(); }
+
+        string info() override { return string(); }
+
+        double cutoff() const override { return 0; }
+    };
+
+    template<class Tspace, class T1, class... Tn>
+    class StaticHamiltonian<Tspace, T1, Tn...> final : public Energybase<Tspace>
+    {
+    private:
+        typedef Energybase<Tspace> Tbase;
+        typedef StaticHamiltonian<Tspace, Tn...> Trest;
+        typedef typename Tbase::Tparticle Tparticle;
+        typedef typename Tbase::Tpvec Tpvec;
+
+        static_assert(std::is_base_of<Tbase, T1>::value, "Energy terms must be derived from `Energybase`");
+
+        string _info() override { return first.info() + rest.info(); }
+
+    public:
+        T1 first;
+        Trest rest;
+
+        StaticHamiltonian( const T1 &a, const Tn &... b ) : first(a), rest(b...) { Tbase::name = "Static Hamiltonian"; }
+
+        StaticHamiltonian( Tmjson &j ) : first(j), rest(j) { Tbase::name = "Static Hamiltonian"; }
+
+        auto tuple() -> decltype(std::tuple_cat(first.tuple(), rest.tuple()))
+        {
+            return std::tuple_cat(first.tuple(), rest.tuple());
+        }
+
+        string info() override { return _info(); }
+
+        void setSpace( Tspace &s ) override
+        {
+            first.T1::setSpace(s);
+            rest.Trest::setSpace(s);
+            Tbase::setSpace(s);
+        }
+
+        void setGeometry( typename Tspace::GeometryType &g ) override
+        {
+            first.T1::setGeometry(g);
+            rest.Trest::setGeometry(g);
+            Tbase::setGeometry(g);
+        }
+
+        double p2p( const Tparticle &a, const Tparticle &b ) override
+        {
+            return first.T1::p2p(a, b) + rest.Trest::p2p(a, b);
+        }
+
+        Point f_p2p( const Tparticle &a, const Tparticle &b ) override
+        {
+            return first.T1::f_p2p(a, b) + rest.Trest::f_p2p(a, b);
+        }
+
+        double all2p( const Tpvec &p, const Tparticle &a ) override
+        {
+            return first.T1::all2p(p, a) + rest.Trest::all2p(p, a);
+        }
+
+        double i2i( const Tpvec &p, int i, int j ) override
+        {
+            return first.T1::i2i(p, i, j) + rest.Trest::i2i(p, i, j);
+        }
+
+        double i2g( const Tpvec &p, Group &g, int i ) override
+        {
+            return first.T1::i2g(p, g, i) + rest.Trest::i2g(p, g, i);
+        }
+
+        double i2all( Tpvec &p, int i ) override { return first.T1::i2all(p, i) + rest.Trest::i2all(p, i); }
+
+        double i_external( const Tpvec &p, int i ) override
+        {
+            return first.T1::i_external(p, i) + rest.Trest::i_external(p, i);
+        }
+
+        double i_internal( const Tpvec &p, int i ) override
+        {
+            return first.T1::i_internal(p, i) + rest.Trest::i_internal(p, i);
+        }
+
+        double p_external( const Tparticle &a ) override
+        {
+            return first.T1::p_external(a) + rest.Trest::p_external(a);
+        }
+
+        double g2g( const Tpvec &p, Group &g1, Group &g2 ) override
+        {
+            return first.T1::g2g(p, g1, g2) + rest.Trest::g2g(p, g1, g2);
+        }
+
+        double g1g2( const Tpvec &p1, Group &g1, const Tpvec &p2, Group &g2 ) override
+        {
+            return first.T1::g1g2(p1, g1, p2, g2) + rest.Trest::g1g2(p1, g1, p2, g2);
+        }
+
+        double g_external( const Tpvec &p, Group &g ) override
+        {
+            return first.T1::g_external(p, g) + rest.Trest::g_external(p, g);
+        }
+
+        double g_internal( const Tpvec &p, Group &g ) override
+        {
+            return first.T1::g_internal(p, g) + rest.Trest::g_internal(p, g);
+        }
+
+        double external( const Tpvec &p ) override { return first.T1::external(p) + rest.Trest::external(p); }
+
+        double update( bool b ) override { return first.T1::update(b) + rest.Trest::update(b); }
+
+        bool concurrent() const override { return first.T1::concurrent() && rest.Trest::concurrent(); }
+
+        bool pairwise() const override { return first.T1::pairwise() && rest.Trest::pairwise(); }
+
+        double cutoff() const override { return std::max(first.T1::cutoff(), rest.Trest::cutoff()); }
+
+        Tmjson json() const override { return merge(first.T1::json(), rest.Trest::json()); }
+
+        double updateChange( const typename Tspace::Change &c ) override
+        {
+            return first.T1::updateChange(c) + rest.Trest::updateChange(c);
+        }
+
+        bool scaledEnergyChange( double s, double &du ) override
+        {
+            double du1, du2;
+            if ( first.T1::scaledEnergyChange(s, du1) && rest.Trest::scaledEnergyChange(s, du2))
+            {
+                du = du1 + du2;
+                return true;
+            }
+            return false;
+        }
+
+        double v2v( const Tpvec &p1, const Tpvec &p2 ) override
+        {
+            return first.T1::v2v(p1, p2) + rest.Trest::v2v(p1, p2);
+        }
+
+        void field( const Tpvec &p, Eigen::MatrixXd &E ) override
+        {
+            first.T1::field(p, E);
+            rest.Trest::field(p, E);
+        }
+    };
+
     template<class Tgeometry> struct FunctorScalarDist
     {
         template<class Tparticle>
@@ -766,7 +1092,42 @@ namespace Faunus
         }
     };
 
+    /**
+     * @brief Test if pair potential has a batched `batch()` function
+     *
+     * See for example `Potential::CoulombGalore::batch()`.
+     */
+    template<class Tpairpot, class Tparticle>
+    struct HasBatch
+    {
+        template<class T>
+        static auto test( int ) -> decltype(std::declval<T &>().batch(
+            std::declval<const Tparticle &>(), std::declval<const ParticleArrays &>(),
+            (const double *) nullptr, 0, 0), std::true_type());
+
+        template<class>
+        static std::false_type test( ... );
+
+        static const bool value = decltype(test<Tpairpot>(0))::value;
+    };
+
 /**
+     * @brief Range of a pair potential; infinity if not truncated
+     *
+     * Largest of `cutoff` in the given JSON section and the pair
+     * cutoffs reported by `PairPotentialBase::rcut2`.
+     */
+    template<class Tpairpot>
+    double pairRange( Tmjson &j, const Tpairpot &pairpot )
+    {
+        double rc = j.value("cutoff", 0.0);
+        for ( auto &i : pairpot.rcut2.m )
+            for ( auto rc2 : i )
+                rc = std::max(rc, std::sqrt(rc2));
+        return (rc > 0) ? rc : pc::infty;
+    }
+
+    /**
      * @brief Energy class for non-bonded interactions.
      *
      * `Tpairpot` is expected to be a pair potential with the following
@@ -777,18 +1138,110 @@ namespace Faunus
      *
      * For a list of implemented potentials, see the `Faunus::Potential`
      * namespace.
+     *
+     * If the pair potential provides a `batch()` function evaluating the
+     * energy with a range of particles (see `HasBatch`) and `batch=true`
+     * is given in the input section, `i2all` and `i2g` will
+     * loop over the contiguous `Space::arrays()` instead of the particle
+     * vector. This requires that the particle vectors are modified
+     * only through moves, see `Space::enableArrays()`.
+     *
+     * If the pair potential is a sum of inverse powers of the distance
+     * (see `Potential::PowerLaw`) and `powerlaw=true` is given in the input
+     * section, the total energy is kept split into its power components
+     * and `scaledEnergyChange()` returns the energy of a uniformly scaled
+     * volume from these. The components are built lazily on a volume move,
+     * with one \f$ O(N^2) \f$ pass instead of the two needed to evaluate the
+     * energy at the old and new volume, and are kept through accepted
+     * volume moves and rejected moves of any kind. Other moves add no cost
+     * but invalidate the components when accepted. This requires that all
+     * groups are atomic or consist of single particle molecules: volume moves
+     * scale only the mass centres of larger molecules, so distances between
+     * their particles do not scale uniformly and the energy is not a sum of
+     * scaled power terms.
      */
     template<class Tspace, class Tpairpot>
     class Nonbonded : public Energybase<Tspace>
     {
     protected:
         string
-        _info() override { return pairpot.info(25); }
+        _info() override
+        {
+            string s = pairpot.info(25);
+            if ( useBatch )
+                s += textio::pad(textio::SUB, 25, "Batched evaluation") + "yes\n";
+            if ( usePowerLaw )
+                s += textio::pad(textio::SUB, 25, "Power law volume scaling") + "yes\n";
+            return s;
+        }
 
         typedef Energybase<Tspace> Tbase;
         typedef typename Tbase::Tparticle Tparticle;
         typedef typename Tbase::Tpvec Tpvec;
 
+    private:
+        bool useBatch;             // use batched pair potential?
+
+        /* Energy of particle `i` with particles [first,last) via `pairpot.batch()` */
+        double batch( const Tpvec &p, int i, int first, int last, std::true_type )
+        {
+            if ( first >= last )
+                return 0;
+            static thread_local std::vector<double> r2buf; // squared distances
+            const ParticleArrays &b = Tbase::spc->arrays(p);
+            r2buf.resize(last - first);
+            Geometry::sqdist(geo, p[i], b, first, last, r2buf.data());
+            return pairpot.batch(p[i], b, r2buf.data(), first, last);
+        }
+
+        double batch( const Tpvec &, int, int, int, std::false_type )
+        {
+            assert(!"Pair potential does not support batched evaluation");
+            return 0;
+        }
+
+        double batch( const Tpvec &p, int i, int first, int last )
+        {
+            return batch(p, i, first, last,
+                         std::integral_constant<bool, HasBatch<Tpairpot, Tparticle>::value>());
+        }
+
+        /* True if batched pair evaluation can be used for particle vector */
+        bool batchable( const Tpvec &p ) const
+        {
+            return useBatch && (&p == &Tbase::spc->p || Tbase::isTrial(p));
+        }
+
+        double range;              // interaction range, see `pairRange()`
+        bool usePowerLaw;          // track inverse power energy terms?
+        bool termsValid;           // `uterms` matches the current configuration?
+        bool scalable;             // all groups scale uniformly, see `scaledEnergyChange()`
+        bool scalableValid;        // `scalable` matches the current groups?
+        bool scalePending;         // `sterms` holds change due to volume scaling
+        bool geometryPending;      // current change is a geometry change
+        Point termsLen;            // geometry side lengths for which `uterms` is valid
+        Potential::PowerTerms uterms, sterms;
+
+        /* Inverse power terms of all pairs */
+        void powerTerms( const Tpvec &p, Potential::PowerTerms &t, std::true_type )
+        {
+            t.fill(0);
+            int n = (int) p.size();
+            for ( int i = 0; i < n - 1; i++ )
+                for ( int j = i + 1; j < n; j++ )
+                    pairpot.powerTerms(p[i], p[j], geo.sqdist(p[i], p[j]), t);
+        }
+
+        void powerTerms( const Tpvec &, Potential::PowerTerms &, std::false_type )
+        {
+            assert(!"Pair potential is not a sum of inverse powers");
+        }
+
+        void powerTerms( const Tpvec &p, Potential::PowerTerms &t )
+        {
+            powerTerms(p, t, std::integral_constant<bool, Potential::PowerLaw<Tpairpot>::value>());
+        }
+
     public:
         typename Tspace::GeometryType geo;
         Tpairpot pairpot;
@@ -804,8 +1257,14 @@ namespace Faunus
                 std::is_base_of<Potential::PairPotentialBase, Tpairpot>::value,
                 "Tpairpot must be a pair potential");
             Tbase::name = "Nonbonded N" + textio::squared + " - " + pairpot.name;
+            useBatch = HasBatch<Tpairpot, Tparticle>::value && j["energy"][sec].value("batch", false);
+            usePowerLaw = Potential::PowerLaw<Tpairpot>::value && j["energy"][sec].value("powerlaw", false);
+            termsValid = scalable = scalableValid = scalePending = geometryPending = false;
+            range = pairRange(j["energy"][sec], pairpot);
         }
 
+        double cutoff() const override { return range; }
+
         auto tuple() -> decltype(std::make_tuple(this))
         {
             return std::make_tuple(this);
@@ -813,9 +1272,85 @@ namespace Faunus
 
         void setSpace( Tspace &s ) override
         {
-            geo = s.geo;
             Tbase::setSpace(s);
             pairpot.setSpace(s);
+            if ( useBatch )
+                s.enableArrays();
+        }
+
+        void setGeometry( typename Tspace::GeometryType &g ) override
+        {
+            geo = g;
+            Tbase::setGeometry(g);
+            pairpot.setGeometry(*Tbase::spc, g);
+        }
+
+        double updateChange( const typename Tspace::Change &c ) override
+        {
+            scalePending = false;
+            geometryPending = c.geometryChange; // resolved by scaledEnergyChange()
+            if ( c.empty() || !c.inGroup.empty() || !c.rmGroup.empty())
+                scalableValid = false;
+            return 0;
+        }
+
+        /** @brief Apply pending volume scaling of inverse power terms, or invalidate them */
+        double update( bool acc ) override
+        {
+            if ( acc )
+            {
+                termsValid = geometryPending && scalePending;
+                if ( termsValid )
+                    for ( size_t n = 0; n < uterms.size(); n++ )
+                        uterms[n] += sterms[n];
+                termsLen = Tbase::spc->geo.len;
+            }
+            scalePending = geometryPending = false;
+            return 0;
+        }
+
+        /**
+         * @brief Energy change when scaling all distances by `s`
+         *
+         * With \f$ U_n \f$ being the energy of all pairs due to the
+         * \f$ r^{-n} \f$ term, the change is
+         * \f$ \sum_n U_n (s^{-n}-1) \f$. Whether all groups scale
+         * uniformly is cached and checked again only after insertions,
+         * deletions and unknown changes.
+         */
+        bool scaledEnergyChange( double s, double &du ) override
+        {
+            if ( !usePowerLaw )
+                return false;
+            auto &spc = *Tbase::spc;
+            if ( !scalableValid )
+            {
+                scalable = true;
+                for ( auto g : spc.groupList())
+                    if ( !g->isAtomic() && g->numMolecules() != g->size())
+                        scalable = false;
+                scalableValid = true;
+            }
+            if ( !scalable )
+                return false;
+            if ( !termsValid || termsLen != spc.geo.len )
+            {
+                powerTerms(spc.p, uterms);
+                termsLen = spc.geo.len;
+                termsValid = true;
+            }
+            du = 0;
+            sterms.fill(0);
+            for ( size_t n = 1; n < uterms.size(); n++ )
+            {
+                if ( uterms[n] != 0 )
+                {
+                    sterms[n] = uterms[n] * (std::pow(s, -double(n)) - 1);
+                    du += sterms[n];
+                }
+            }
+            scalePending = true;
+            return true;
         }
 
         //!< Particle-particle energy (kT)
@@ -847,6 +1382,12 @@ namespace Faunus
         double i2g( const Tpvec &p, Group &g, int j ) override
         {
             double u = 0;
+            if ( !g.empty() && batchable(p))
+            {
+                if ( g.find(j))
+                    return batch(p, j, g.front(), j) + batch(p, j, j + 1, g.back() + 1);
+                return batch(p, j, g.front(), g.back() + 1);
+            }
             if ( !g.empty())
             {
                 int len = g.back() + 1;
@@ -869,6 +1410,8 @@ namespace Faunus
             assert(i >= 0 && i < int(p.size()) && "index i outside particle vector");
             double u = 0;
             int n = (int) p.size();
+            if ( batchable(p))
+                return batch(p, i, 0, i) + batch(p, i, i + 1, n);
             for ( int j = 0; j != i; ++j )
                 u += pairpot(p[i], p[j], geo.sqdist(p[i], p[j]));
             for ( int j = i + 1; j < n; ++j )
@@ -1004,6 +1547,9 @@ namespace Faunus
             return pairpot(p[i], p[j], geo.sqdist(p[i], p[j])) * excl(i, j);
         }
 
+        /* Excluded pairs are not part of the power terms */
+        bool scaledEnergyChange( double, double & ) override { return false; }
+
         double i2g( const Tpvec &p, Group &g, int j ) override
         {
             double u = 0;
@@ -1085,10 +1631,11 @@ namespace Faunus
             groupBasedField = in.value("pol_g2g", false);
         }
 
-        void setSpace( Tspace &s ) override
+        void setGeometry( typename Tspace::GeometryType &g ) override
         {
-            geo = s.geo;
-            Tbase::setSpace(s);
+            geo = g;
+            Tbase::setGeometry(g);
+            pairpot.setGeometry(*Tbase::spc, g);
         }
 
         auto tuple() -> decltype(std::make_tuple(this))
@@ -1373,6 +1920,12 @@ namespace Faunus
             return cut(p, g1, g2) ? 0 : base::g2g(p, g1, g2);
         }
 
+        /* Cut pairs do not scale with the volume */
+        bool scaledEnergyChange( double, double & ) override { return false; }
+
+        /* The cut depends on the mass centers of whole groups */
+        bool pairwise() const override { return false; }
+
         double g1g2( const Tpvec &p1, Group &g1, const Tpvec &p2, Group &g2 ) override
         {
             return cut(p1, g1, p2, g2) ? 0 : base::g1g2(p1, g1, p2, g2);
@@ -1596,7 +2149,7 @@ namespace Faunus
             assert(i != j);
             auto f = this->list.find(opair<int>(i, j));
             if ( f != this->list.end())
-                return f->second(p[i], p[j], spc->geo.sqdist(p[i], p[j]));
+                return f->second(p[i], p[j], this->getGeometry().sqdist(p[i], p[j]));
             return 0;
         }
 
@@ -1613,7 +2166,7 @@ namespace Faunus
             auto f = force_list.find(opair<int>(i, j));
             if ( f != this->force_list.end())
             {
-                auto r = spc->geo.vdist(a, b);
+                auto r = this->getGeometry().vdist(a, b);
                 return f->second(a, b, r.squaredNorm(), r);
             }
             return Point(0, 0, 0);
@@ -1629,7 +2182,28 @@ namespace Faunus
             {
                 int j = it->second; // partner index
                 u += this->list[opair<int>(i, j)](
-                    p[i], p[j], spc->geo.sqdist(p[i], p[j]));
+                    p[i], p[j], this->getGeometry().sqdist(p[i], p[j]));
+            }
+            return u;
+        }
+
+        /**
+             * @brief Bonds of i'th particle with particles in g
+             *
+             * Bonds to particles of another group are skipped unless
+             * `CrossGroupBonds` is set, as in `g2g()`.
+             */
+        double i2g( const Tpvec &p, Group &g, int i ) override
+        {
+            double u = 0;
+            auto eqr = this->mlist.equal_range(i);
+            for ( auto it = eqr.first; it != eqr.second; ++it )
+            {
+                int j = it->second; // partner index
+                if ( g.find(j))
+                    if ( CrossGroupBonds || spc->findGroup(i) == spc->findGroup(j))
+                        u += this->list[opair<int>(i, j)](
+                            p[i], p[j], this->getGeometry().sqdist(p[i], p[j]));
             }
             return u;
         }
@@ -1642,7 +2216,7 @@ namespace Faunus
                 int i = m.first.first;
                 int j = m.first.second;
                 assert(i >= 0 && i < (int) p.size() && j >= 0 && j < (int) p.size()); //debug
-                u += m.second(p[i], p[j], spc->geo.sqdist(p[i], p[j]));
+                u += m.second(p[i], p[j], this->getGeometry().sqdist(p[i], p[j]));
             }
             return u;
         }
@@ -1667,8 +2241,8 @@ namespace Faunus
                     {
                         int j = it->second; // partner index
                         if ( g2.find(j))
-                            u += this->list[opair<int>(i, j)](
-                                p[i], p[j], spc->geo.sqdist(p[i], p[j]));
+                            u += this->list.at(opair<int>(i, j))(
+                                p[i], p[j], this->getGeometry().sqdist(p[i], p[j]));
                     }
                 }
             return u;
@@ -1694,7 +2268,7 @@ namespace Faunus
                     {
                         auto it = this->list.find(opair<int>(i, j));
                         if ( it != end )
-                            u += it->second(p[i], p[j], spc->geo.sqdist(p[i], p[j]));
+                            u += it->second(p[i], p[j], this->getGeometry().sqdist(p[i], p[j]));
                     }
             }
             else
@@ -1705,7 +2279,7 @@ namespace Faunus
                     int i = m.first.first, j = m.first.second;
                     if ( g.find(i))
                         if ( g.find(j))
-                            u += m.second(p[i], p[j], spc->geo.sqdist(p[i], p[j]));
+                            u += m.second(p[i], p[j], this->getGeometry().sqdist(p[i], p[j]));
                 }
             }
             return u;
@@ -1783,6 +2357,8 @@ namespace Faunus
         //!< Add energy change disrepancy, dU = U(metropolis) - U(as in drift calculation)
         void add( double du ) { usum += du; }
 
+        double cutoff() const override { return 0; }
+
         //!< Dumme rest treated as external potential to whole system
         double external( const typename Energybase<Tspace>::Tpvec &p ) override
         {
@@ -1874,10 +2450,12 @@ namespace Faunus
 
         auto tuple() -> decltype(std::make_tuple(this)) { return std::make_tuple(this); }
 
+        double cutoff() const override { return 0; }
+
         /** @brief External energy working on system. pV/kT-lnV */
         double external( const Tpvec &p ) override
         {
-            double V = this->getSpace().geo.getVolume();
+            double V = this->getGeometry().getVolume();
             assert(V > 1e-9 && "Volume must be non-zero!");
             return P * V - log(V);
         }
@@ -1888,9 +2466,22 @@ namespace Faunus
             if ( ignore.count(&g) != 0 )
                 return 0;
             int N = g.numMolecules();
-            double V = this->getSpace().geo.getVolume();
+            double V = this->getGeometry().getVolume();
             return -N * log(V);
         }
+
+        /** @brief Change of `external()` and `g_external()` summed over all groups */
+        bool scaledEnergyChange( double s, double &du ) override
+        {
+            auto &spc = this->getSpace();
+            double Vold = spc.geo.getVolume(), Vnew = spc.geo_trial.getVolume();
+            int N = 1;
+            for ( auto g : spc.groupList())
+                if ( ignore.count(g) == 0 )
+                    N += g->numMolecules();
+            du = P * (Vnew - Vold) - N * log(Vnew / Vold);
+            return true;
+        }
     };
 
 /**
@@ -1915,6 +2506,8 @@ namespace Faunus
             base::name = "External Potential (" + expot.name + ")";
         }
 
+        double cutoff() const override { return 0; }
+
         double p_external( const typename base::Tparticle &p ) override
         {
             return expot(p);
@@ -2042,14 +2635,14 @@ namespace Faunus
                     else
                         id2 = m.first.first;
 
-                    Point cm1 = Geometry::massCenter(spc->geo, p, g1);
+                    Point cm1 = Geometry::massCenter(this->getGeometry(), p, g1);
 
                     auto g2vec = spc->findMolecules(id2);
                     for ( auto g2 : g2vec )
                         if ( &g1 != g2 )
                         {
-                            Point cm2 = Geometry::massCenter(spc->geo, p, *g2);
-                            double r2 = spc->geo.sqdist(cm1, cm2);
+                            Point cm2 = Geometry::massCenter(this->getGeometry(), p, *g2);
+                            double r2 = this->getGeometry().sqdist(cm1, cm2);
                             double min = m.second.mindist;
                             double max = m.second.maxdist;
                             if ( r2 < min * min || r2 > max * max )
@@ -2208,6 +2801,10 @@ namespace Faunus
 
         auto tuple() -> decltype(std::make_tuple(this)) { return std::make_tuple(this); }
 
+        bool concurrent() const override { return false; } // `g2g()` uses shared scratch and sampling
+
+        bool pairwise() const override { return false; } // surface area of whole groups
+
         /** @brief Group-to-group energy */
         double g2g( const Tpvec &p, Group &g1, Group &g2 ) override
         {
@@ -2228,7 +2825,7 @@ namespace Faunus
                                             if ( sasa[j] > 1e-3 )
                                                 if ( v[i] || v[j] )
                                                 {
-                                                    double r2 = base::spc->geo.sqdist(p[i], p[j]);
+                                                    double r2 = base::getGeometry().sqdist(p[i], p[j]);
                                                     if ( r2 < pow(threshold + p[i].radius + p[j].radius, 2))
                                                     {
                                                         if ( v[i] )
@@ -2973,7 +3570,7 @@ namespace Faunus
         {
             double u = 0;
             for ( auto &f : list )
-                u += f(Tbase::spc->geo, p);
+                u += f(Tbase::getGeometry(), p);
             return u;
         }
     };
@@ -3179,6 +3776,13 @@ class SASAEnergy : public Energybase<Tspace> {
                 b->setSpace(s);
         }
 
+        void setGeometry( typename Tspace::GeometryType &g ) override
+        {
+            Tbase::setGeometry(g);
+            for ( auto b : baselist )
+                b->setGeometry(g);
+        }
+
         double p2p( const Tparticle &p1, const Tparticle &p2 ) override
         {
             double u = 0;
@@ -3331,13 +3935,39 @@ class SASAEnergy : public Energybase<Tspace> {
          */
         virtual double systemEnergy( const Tpvec &p )
         {
-            double u = external(p);
-            for ( auto g : Energybase<Tspace>::spc->groupList())
-                u += g_external(p, *g) + g_internal(p, *g);
-            for ( unsigned int i = 0; i < Energybase<Tspace>::spc->groupList().size() - 1; i++ )
-                for ( unsigned int j = i + 1; j < Energybase<Tspace>::spc->groupList().size(); j++ )
-                    u += g2g(p, *Energybase<Tspace>::spc->groupList()[i], *Energybase<Tspace>::spc->groupList()[j]);
-            return u;
+            return Tbase::systemEnergy(p);
+        }
+
+        bool concurrent() const override
+        {
+            for ( auto b : baselist )
+                if ( !b->concurrent())
+                    return false;
+            return true;
+        }
+
+        bool pairwise() const override
+        {
+            for ( auto b : baselist )
+                if ( !b->pairwise())
+                    return false;
+            return true;
+        }
+
+        double cutoff() const override
+        {
+            double rc = 0;
+            for ( auto b : baselist )
+                rc = std::max(rc, b->cutoff());
+            return rc;
+        }
+
+        Tmjson json() const override
+        {
+            Tmjson j;
+            for ( auto b : baselist )
+                j = merge(j, b->json());
+            return j;
         }
 
         /**
@@ -3429,16 +4059,20 @@ class SASAEnergy : public Energybase<Tspace> {
                   if ( c.mvGroup.count(j) == 0 )                // If group j is not in mvGroup
                       du += pot.g2g(p, *g[i], *g[j]);*/           // moved group<->static groups
 
-              du += pot.g_external(p, *g[i]);                   // moved group <-> external
-
-              if ( g[i]->isAtomic() )
-              {                                                 // Check if moved group is atomic
-                  for ( auto j : m.second )                     // loop over all moved groups
-                      for ( auto k : *g[i] )                    // loop over all atoms in moved group
-                          if ( std::find(m.second.begin(), m.second.end(), k) == m.second.end() || j
-                              > k ) // check such that moved atoms does not interact OR moved atoms interact only once
-                              du += pot.i2i(p, j, k);
+              if ( g[i]->isAtomic() && !m.second.empty() )      // only listed atoms have moved
+              {
+                  for ( auto j : m.second )
+                  {
+                      du += pot.i_external(p, j);               // moved atom <-> external
+                      du += pot.i2g(p, *g[i], j);               // moved atom <-> own group
+                  }
+                  for ( size_t j = 0; j < m.second.size(); j++ ) // moved atoms were counted twice
+                      for ( size_t k = j + 1; k < m.second.size(); k++ )
+                          du -= pot.i2i(p, m.second[j], m.second[k]);
               }
+              else
+                  du += pot.g_external(p, *g[i]);               // moved group <-> external
+
               if ( g[i]->isMolecular() )
               {
                   if (!m.second.empty()) // only recalculate internal energy if N>0
@@ -3460,6 +4094,56 @@ class SASAEnergy : public Energybase<Tspace> {
           return du;
       }
 
+    /**
+     * @brief Energy of a contiguous segment of group `g` with the rest of the system
+     *
+     * The segment interacts with the remaining particles of `g`, the
+     * sub-ranges before and after `seg`, and with all other groups, all
+     * evaluated with `i2g()`. Pairs within the segment are left out so the
+     * segment must move as a rigid body or be a single particle, and the
+     * energy must be `Energybase::pairwise()`. External energies are not
+     * included.
+     */
+      template<class Tenergy, class Tpvec, class Tgeo, class Tparticle>
+      double segmentEnergy( Space<Tgeo,Tparticle> &spc, Tenergy &pot, const Tpvec &p, Group &g, Group &seg )
+      {
+          assert(pot.pairwise() && "Group based energies require the full group energy");
+          assert(g.find(seg.front()) && g.find(seg.back()));
+          Group before(g.front(), seg.front() - 1), after(seg.back() + 1, g.back());
+          double u = 0;
+          for ( auto i : seg )
+              u += pot.i2g(p, before, i) + pot.i2g(p, after, i); // segment <-> rest of g
+          if ( u == pc::infty )
+              return pc::infty;   // early rejection
+          for ( auto gj : spc.groupList())
+              if ( gj != &g )
+              {
+                  for ( auto i : seg )
+                      u += pot.i2g(p, *gj, i);                    // segment <-> other groups
+                  if ( u == pc::infty )
+                      return pc::infty;
+              }
+          return u;
+      }
+
+    /**
+     * @brief Evaluate `f()` with the energy bound to the trial geometry
+     *
+     * The energy terms are rebound to `Space::geo_trial` using
+     * `Energybase::setGeometry()` and back to `Space::geo` afterwards.
+     * In contrast to `setSpace()` this only exchanges geometry pointers (and
+     * the geometry copies kept by pair loops) and neither `Space::geo` nor
+     * any other state of the energy terms is touched.
+     */
+      template<class Tenergy, class Tgeometry, class Tparticle, class Tfunction>
+      auto evaluateTrialGeometry( Space<Tgeometry, Tparticle> &s, Tenergy &pot, Tfunction f ) -> decltype(f())
+      {
+          pot.setGeometry(s.geo_trial);
+          auto result = f();
+          pot.setGeometry(s.geo);
+          return result;
+      }
+
     /**
      * @brief Calculate energy change due to proposed modification defined by `Space::Change`
      */
@@ -3472,37 +4156,25 @@ class SASAEnergy : public Energybase<Tspace> {
           if (c.empty())
               return 0;
 
-          auto backup = s.geo; // backup geometry;
-
-          // make sure the new (trial) geometry is active
-          if ( c.geometryChange )
-          {
-              s.geo = s.geo_trial;
-              pot.setSpace(s);
-          }
-
-          // Check for container overlap
-
+          // Check for container overlap in the (trial) geometry
+          auto &geo = c.geometryChange ? s.geo_trial : s.geo;
           for ( auto &m : c.mvGroup )  // loop over all moved groups
               if ( m.second.empty())  // if index vector is empty, assume that all particles have moved
               {
                   for ( auto j : *s.groupList()[m.first] )
-                      if ( s.geo.collision(s.trial[j], s.trial[j].radius, Geometry::Geometrybase::BOUNDARY))
+                      if ( geo.collision(s.trial[j], s.trial[j].radius, Geometry::Geometrybase::BOUNDARY))
                           return pc::infty;
               }
               else
                   for ( auto j : m.second ) // if given, loop over specific particle index
-                      if ( s.geo.collision(s.trial[j], s.trial[j].radius, Geometry::Geometrybase::BOUNDARY))
+                      if ( geo.collision(s.trial[j], s.trial[j].radius, Geometry::Geometrybase::BOUNDARY))
                           return pc::infty;
 
-          double duNew = energyChangeConfiguration(s, pot, s.trial, c);
-
-          // restore original geometry
+          double duNew;
           if ( c.geometryChange )
-          {
-              s.geo = backup;
-              pot.setSpace(s);
-          }
+              duNew = evaluateTrialGeometry(s, pot, [&]() { return energyChangeConfiguration(s, pot, s.trial, c); });
+          else
+              duNew = energyChangeConfiguration(s, pot, s.trial, c);
 
           double duOld = energyChangeConfiguration(s, pot, s.p, c);
 
@@ -3559,6 +4231,13 @@ class SASAEnergy : public Energybase<Tspace> {
               Tbase::setSpace(s);
           }
 
+          void setGeometry( typename T1::SpaceType::GeometryType &g ) override
+          {
+              first.setGeometry(g);
+              second.setGeometry(g);
+              Tbase::setGeometry(g);
+          }
+
           double p2p( const Tparticle &a, const Tparticle &b ) override { return first.p2p(a, b); }
 
           Point f_p2p( const Tparticle &a, const Tparticle &b ) override
@@ -3598,6 +4277,14 @@ class SASAEnergy : public Energybase<Tspace> {
               return a;
           }
 
+          bool concurrent() const override { return first.concurrent() && second.concurrent(); }
+
+          bool pairwise() const override { return first.pairwise() && second.pairwise(); }
+
+          double cutoff() const override { return std::max(first.cutoff(), second.cutoff()); }
+
+          Tmjson json() const override { return merge(first.json(), second.json()); }
+
           double g1g2( const Tpvec &p1, Group &g1, const Tpvec &p2, Group &g2 ) override
           {
               return first.g1g2(p1, g1, p2, g2);
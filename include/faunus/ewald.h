@@ -4,6 +4,7 @@
 #include <faunus/auxiliary.h>
 #include "faunus/inputfile.h"
 #include <faunus/tabulate.h>
+#include <faunus/fft.h>
 #include <complex>
 
 namespace Faunus {
@@ -69,6 +70,18 @@ namespace Faunus {
 	  T2_tabulator.setRange(0,rc);
 	  updateSpline();
         }
+
+        /** @brief Set damping and cut-off, regenerating the splines only once */
+        void update(double alpha_in, double rc_in) {
+          alpha = alpha_in;
+          alpha2 = alpha*alpha;
+          rc = rc_in;
+	  rc2 = rc*rc;
+	  T0_tabulator.setRange(0,rc);
+	  T1_tabulator.setRange(0,rc);
+	  T2_tabulator.setRange(0,rc);
+	  updateSpline();
+        }
         
         void updateSpline() {
 	  table_T0 = T0_tabulator.generate( T0_sf );
@@ -177,6 +190,7 @@ namespace Faunus {
      * `cutoffK_y`       |  Maximum number of vectors in y-axis in k-space for ions. Is overridden if 'cutoffK' is set.                      (Default: According to DOI: (Ions) 10.1080/08927029208049126 or (Dipoles) 10.1063/1.1398588 )  
      * `cutoffK_z`       |  Maximum number of vectors in z-axis in k-space for ions. Is overridden if 'cutoffK' is set.                      (Default: According to DOI: (Ions) 10.1080/08927029208049126 or (Dipoles) 10.1063/1.1398588 )  
      * `update_frequency`|  The frequency of how often the total sum of all complex numbers are updated (an optimization optin).             (Default: Number of particles in system)
+     * `autotune`        |  Choose `alpha`, `cutoff` and `cutoffK` at start-up from measured kernel timings, subject to `delta`. Given values are ignored. (Default: false)
      * `tab_utol`        |  Tolerance of splined energy-error. Only used if isotropic interactions alone are handled.                        (Default: \f$ 10^{-9}\f$)
      * `tab_ftol`        |  Tolerance of splined force-error. Only used if isotropic interactions alone are handled.                         (Default: \f$ 10^{-5}\f$)
      * 
@@ -207,7 +221,6 @@ namespace Faunus {
      * {\bf k} = 2\pi\left( \frac{n_x}{L_x} , \frac{n_y}{L_y} ,\frac{n_z}{L_z} \right)  \;\;,\;\; {\bf n} \in \mathbb{Z}^3
      * @f]
      * 
-     * @todo Need to implement measurement of the average evaluation time for real part of Ewald, this in order to get optimal parametrization to work properly.
      * @warning Current version is constucted such that paramaters can not be correctly updated during a run if splines are used (i.e. only isotropic Coulomb is handled).
      * @warning Ewald summation does not work properly at the moment.
      * 
@@ -229,11 +242,14 @@ namespace Faunus {
 	  EwaldParameters<useIonIon,useIonDipole,useDipoleDipole> parameters;
           int kVectorsInUse, kVectorsInUse_trial, N, cnt_accepted, update_frequency;
           double V, V_trial, surfaceEnergy, surfaceEnergyTrial, reciprocalEnergy, reciprocalEnergyTrial, eps_surf, const_inf, lB, update_drift; 
-          bool spherical_sum, isotropic_pbc;
+          bool spherical_sum, isotropic_pbc, autotune;
+          double delta, time_real, time_reciprocal; // accuracy target and measured kernel timings (microseconds per particle)
           vector<complex<double>> Q_ion_tot, Q_dip_tot, Q_ion_tot_trial, Q_dip_tot_trial;
           typename Tspace::Change change;
+          vector<int> moved; // indices of particles moved in the current trial
 
           Eigen::MatrixXd kVectors, kVectors_trial;  // Matrices with k-vectors
+          Eigen::MatrixXi kIndices;  // Integer indices of k-vectors in units of 2*pi/L (same for trial and old geometry)
           Eigen::VectorXd Aks, Aks_trial;  // Stores values based on k-vectors in order to minimize computational effort. (See Eq.24 in DOI: 10.1063/1.481216)
           
           /**
@@ -312,10 +328,11 @@ namespace Faunus {
            * @brief Updates all vectors and matrices which depends on the number of k-space vectors.
            * @note Needs to be called whenever 'kcc_x', 'kcc_y' or 'kcc_z' has been updated
            */
-          void kVectorChange(Eigen::MatrixXd &kVectors_in, Eigen::VectorXd &Aks_in, vector<complex<double>> &Q_ion_tot_in, vector<complex<double>> &Q_dip_tot_in, int &kVectorsInUse_in, EwaldParameters<useIonIon,useIonDipole,useDipoleDipole> &parameters_in) const {
+          void kVectorChange(Eigen::MatrixXd &kVectors_in, Eigen::MatrixXi &kIndices_in, Eigen::VectorXd &Aks_in, vector<complex<double>> &Q_ion_tot_in, vector<complex<double>> &Q_dip_tot_in, int &kVectorsInUse_in, EwaldParameters<useIonIon,useIonDipole,useDipoleDipole> &parameters_in) const {
 	    int kVectorsLength = (2*parameters_in.kcc + 1)*(2*parameters_in.kcc + 1)*(2*parameters_in.kcc + 1) - 1;
 	    if(kVectorsLength == 0) {
 	      kVectors_in.resize(3, 1); 
+	      kIndices_in.setZero(3, 1);
 	      Aks_in.resize(1);
 	      kVectors_in.col(0) = Point(1.0,0.0,0.0); // Just so it is not the zero-vector
 	      Aks_in[0] = 0.0;
@@ -325,6 +342,7 @@ namespace Faunus {
 	      return;
 	    }
             kVectors_in.resize(3, kVectorsLength); 
+            kIndices_in.resize(3, kVectorsLength);
             Aks_in.resize(kVectorsLength);
             kVectorsInUse_in = 0;
             kVectors_in.setZero();
@@ -348,6 +366,7 @@ namespace Faunus {
                     if( (dkx2/parameters_in.kc2) + (dky2/parameters_in.kc2) + (dkz2/parameters_in.kc2) > 1.0)
                       continue;
                   kVectors_in.col(kVectorsInUse_in) = kv; 
+                  kIndices_in.col(kVectorsInUse_in) << kx, ky, kz;
                   Aks_in[kVectorsInUse_in] = factor*exp(-k2/(4.0*parameters_in.alpha2))/k2;
                   kVectorsInUse_in++;
                 }
@@ -357,6 +376,35 @@ namespace Faunus {
             Q_dip_tot_in.resize(kVectorsInUse_in);
           }
           
+          /**
+           * @brief Adds the contribution of a particle to the complex numbers at a k-vector
+           * @param a Particle
+           * @param kv k-vector
+           * @param Q_ion Complex number for ions
+           * @param Q_dip Complex number for dipoles
+           */
+          void addComplexNumbers(const Tparticle &a, const Point &kv, complex<double> &Q_ion, complex<double> &Q_dip) const {
+            if (!isotropic_pbc) {
+              double dot = kv.dot(a);
+              double c = cos(dot), s = sin(dot);
+              if (useIonIon || useIonDipole)
+                Q_ion += a.charge * complex<double>(c,s);
+              if (useIonDipole || useDipoleDipole)
+                Q_dip += kv.dot(a.mu()) * a.muscalar() * complex<double>(-s,c);
+              return;
+            }
+            double xx = a.x()*kv.x();
+            double yy = a.y()*kv.y();
+            double zz = a.z()*kv.z();
+            double cosX = cos(xx);
+            double cosY = cos(yy);
+            double cosZ = cos(zz);
+            if (useIonIon || useIonDipole)
+              Q_ion += a.charge*cosX*cosY*cosZ;
+            if (useIonDipole || useDipoleDipole)
+              Q_dip += ( sin(xx)*cosY*cosZ*a.mu().x()*kv.x() + cosX*sin(yy)*cosZ*a.mu().y()*kv.y() + cosX*cosY*sin(zz)*a.mu().z()*kv.z() )*a.muscalar();
+          }
+
           /**
            * @brief Re-calculates the vectors of complex numbers used in getQ2
            * @param p Particle vector
@@ -364,36 +412,184 @@ namespace Faunus {
 	   * @param Q_dip_tot_in Vector of complex numbers for dipoles
 	   * @param kVectors_in k-vectors
 	   * @param kVectorsInUse_in Number of k-vectors (not necessarily the same as the length of 'kVectors_in')
+	   *
+	   * Since all k-vectors are integer multiples of the reciprocal box vectors, the phase factors
+	   * \f$ e^{i n_x b_x x} \f$ (and likewise for y and z) are tabulated for each particle using
+	   * the recurrence \f$ e^{i n b x} = e^{i (n-1) b x} e^{i b x} \f$. Each structure factor is then
+	   * a product of three table columns, evaluated for all particles at once, so that only one
+	   * `sin`/`cos` pair per particle and dimension is required.
            */
           void updateAllComplexNumbers(const Tpvec &p, vector<complex<double>> &Q_ion_tot_in, vector<complex<double>> &Q_dip_tot_in, const Eigen::MatrixXd &kVectors_in, int kVectorsInUse_in) const {
-	     for (int k=0; k<kVectorsInUse_in; k++) {
+            const int n = p.size();
+            if (kVectorsInUse_in < 1)
+              return;
+            const int nmax = kIndices.leftCols(kVectorsInUse_in).cwiseAbs().maxCoeff();
+            const bool ion = (useIonIon || useIonDipole), dip = (useIonDipole || useDipoleDipole);
+
+            Point b(0,0,0); // reciprocal box lengths, 2*pi/L, recovered from the k-vectors
+            for (int d=0; d<3; d++)
+              for (int k=0; k<kVectorsInUse_in; k++)
+                if (kIndices(d,k) != 0) {
+                  b[d] = kVectors_in(d,k) / kIndices(d,k);
+                  break;
+                }
+
+            Eigen::ArrayXXcd eik[3]; // column nmax+m holds exp(i*m*b*x) for all particles
+            for (int d=0; d<3; d++) {
+              eik[d].resize(n, 2*nmax+1);
+              eik[d].col(nmax).setOnes();
+              if (nmax == 0)
+                continue;
+              for (int i=0; i<n; i++)
+                eik[d](i,nmax+1) = std::polar(1.0, b[d]*p[i][d]);
+              for (int m=2; m<=nmax; m++)
+                eik[d].col(nmax+m) = eik[d].col(nmax+m-1) * eik[d].col(nmax+1);
+              for (int m=1; m<=nmax; m++)
+                eik[d].col(nmax-m) = eik[d].col(nmax+m).conjugate();
+            }
+
+            Eigen::ArrayXd q(n), mu[3];
+            for (int d=0; d<3; d++)
+              mu[d].resize(n);
+            for (int i=0; i<n; i++) {
+              q[i] = p[i].charge;
+              for (int d=0; d<3; d++)
+                mu[d][i] = p[i].mu()[d] * p[i].muscalar();
+            }
+
+            Eigen::ArrayXcd e(n);
+            for (int k=0; k<kVectorsInUse_in; k++) {
               Point kv = kVectors_in.col(k);
+              const int nx = nmax+kIndices(0,k), ny = nmax+kIndices(1,k), nz = nmax+kIndices(2,k);
               complex<double> Q_temp_ion(0.0,0.0);
               complex<double> Q_temp_dip(0.0,0.0);
-              for (size_t i = 0; i < p.size(); i++) {
-                double dot = kv.dot(p[i]);
-                if( ( useIonIon || useIonDipole ) && !isotropic_pbc ) {
-                  Q_temp_ion += p[i].charge * complex<double>(cos(dot),sin(dot));
-		} else if( ( useIonIon || useIonDipole ) && isotropic_pbc ) {
-		  Q_temp_ion += p[i].charge*cos(kv.x()*p[i].x())*cos(kv.y()*p[i].y())*cos(kv.z()*p[i].z()); 
-		}
-                if(useDipoleDipole && !isotropic_pbc) {
-                  Q_temp_dip += kv.dot(p[i].mu()) * p[i].muscalar() * complex<double>(-sin(dot),cos(dot));
-		} else if(useDipoleDipole && isotropic_pbc) {
-		  double xx = spc->p[i].x()*kv.x();
-		  double yy = spc->p[i].y()*kv.y();
-		  double zz = spc->p[i].z()*kv.z();
-		  double cosX = cos(xx);
-		  double cosY = cos(yy);
-		  double cosZ = cos(zz);
-		  Q_temp_dip += ( sin(xx)*cosY*cosZ*spc->p[i].mu().x()*kv.x() + cosX*sin(yy)*cosZ*spc->p[i].mu().y()*kv.y() + cosX*cosY*sin(zz)*spc->p[i].mu().z()*kv.z() )*spc->p[i].muscalar();
-		}
+              if (!isotropic_pbc) {
+                e = eik[0].col(nx) * eik[1].col(ny) * eik[2].col(nz);
+                if (ion)
+                  Q_temp_ion = (e*q).sum();
+                if (dip)
+                  Q_temp_dip = complex<double>(0,1) * (e*(kv.x()*mu[0] + kv.y()*mu[1] + kv.z()*mu[2])).sum();
+              } else {
+                if (ion)
+                  Q_temp_ion = (q * eik[0].col(nx).real() * eik[1].col(ny).real() * eik[2].col(nz).real()).sum();
+                if (dip)
+                  Q_temp_dip = ( kv.x()*mu[0]*eik[0].col(nx).imag()*eik[1].col(ny).real()*eik[2].col(nz).real()
+                      + kv.y()*mu[1]*eik[0].col(nx).real()*eik[1].col(ny).imag()*eik[2].col(nz).real()
+                      + kv.z()*mu[2]*eik[0].col(nx).real()*eik[1].col(ny).real()*eik[2].col(nz).imag() ).sum();
               }
               Q_ion_tot_in.at(k) = Q_temp_ion;
               Q_dip_tot_in.at(k) = Q_temp_dip;
             }
           }
 
+          /**
+           * @brief Real and reciprocal space error estimates in \f$ e^2/\AA \f$ (Kolafa and Perram, DOI: 10.1080/08927029208049126)
+           * @param Q2 Sum of squared charges (and dipole moments)
+           */
+          double errorReal(double Q2, double alpha, double rc, double volume) const {
+            return Q2 * sqrt(rc/(2*volume)) * exp(-alpha*alpha*rc*rc) / (alpha*alpha*rc*rc);
+          }
+
+          double errorReciprocal(double Q2, double alpha, int kcc, double L) const {
+            return Q2 * alpha/(pc::pi*pc::pi) * pow(kcc,-1.5) * exp(-pow(pc::pi*kcc/(alpha*L),2));
+          }
+
+          /** @brief Set damping, real space cut-off and k-vectors and refresh splines and complex numbers */
+          void setParameters(double alpha, double rc, int kcc) {
+            parameters.alpha = alpha;
+            parameters.alpha2 = alpha*alpha;
+            parameters.rc = rc;
+            parameters.kc = kcc;
+            parameters.kc2 = parameters.kc*parameters.kc;
+            parameters.kcc = kcc;
+            Tbase::pairpot.first.update(alpha, rc);
+            kVectorChange(kVectors,kIndices,Aks,Q_ion_tot,Q_dip_tot,kVectorsInUse,parameters);
+            updateAllComplexNumbers(spc->p,Q_ion_tot,Q_dip_tot,kVectors,kVectorsInUse);
+            undo();
+          }
+
+          /**
+           * @brief Pick damping, real space cut-off and k-space cut-off from measured kernel timings
+           *
+           * For a set of real space cut-offs, the damping parameter is found so that the real space
+           * error equals `delta`, and the smallest k-space cut-off with a reciprocal error below
+           * `delta` is chosen. For each candidate the cost of a single particle move is measured by
+           * timing the kernels used in a move for a sample of particles: the real space `i2all()`,
+           * the update of the complex numbers in `updateChange()`, and the complete refresh by
+           * `updateAllComplexNumbers()` done every `update_frequency` accepted moves, counted per
+           * move. Timings are averaged over `nrepeat` passes and the fastest candidate is kept.
+           * The parameters and timings are reported by `info()` and `json()`.
+           */
+          void tune() {
+            double Q2 = 0;
+            for (auto &a : spc->p) {
+              if (useIonIon || useIonDipole)
+                Q2 += a.charge*a.charge;
+              if (useIonDipole || useDipoleDipole)
+                Q2 += a.muscalar()*a.muscalar();
+            }
+            if (Q2 < 1e-10)
+              return;
+            double volume = spc->geo.getVolume();
+            double minL = parameters.minL, maxL = parameters.maxL;
+            int nsample = std::min(100, N);
+            int ncand = 6, nrepeat = 5;
+            double best = pc::infty, best_alpha = parameters.alpha, best_rc = parameters.rc;
+            int best_kcc = parameters.kcc;
+
+            for (int n=0; n<ncand; n++) {
+              double rc = 0.5*minL * (0.4 + 0.6*n/(ncand-1));
+              double lo = 1e-3/rc, hi = 10.0/rc; // bisection for alpha: real space error decreases with alpha
+              for (int i=0; i<60; i++) {
+                double mid = 0.5*(lo+hi);
+                if (errorReal(Q2,mid,rc,volume) > delta)
+                  lo = mid;
+                else
+                  hi = mid;
+              }
+              double alpha = hi;
+              int kcc = 1;
+              while (errorReciprocal(Q2,alpha,kcc,maxL) > delta && kcc < 100)
+                kcc++;
+              setParameters(alpha, rc, kcc);
+
+              double sum = 0, treal = 0, trecip = 0;
+              for (int m=0; m<nrepeat; m++) {
+                auto t0 = std::chrono::steady_clock::now();
+                for (int i=0; i<nsample; i++)
+                  sum += Tbase::i2all(spc->p, i*N/nsample);
+                auto t1 = std::chrono::steady_clock::now();
+                for (int i=0; i<nsample; i++) { // as in updateChange(): new and old position of a moved particle
+                  complex<double> Q_ion(0,0), Q_dip(0,0);
+                  const Tparticle &a = spc->p[i*N/nsample];
+                  for (int k=0; k<kVectorsInUse; k++) {
+                    Point kv = kVectors.col(k);
+                    addComplexNumbers(a, kv, Q_ion, Q_dip);
+                    addComplexNumbers(a, kv, Q_ion, Q_dip);
+                  }
+                  sum += std::abs(Q_ion) + std::abs(Q_dip);
+                }
+                auto t2 = std::chrono::steady_clock::now();
+                updateAllComplexNumbers(spc->p,Q_ion_tot,Q_dip_tot,kVectors,kVectorsInUse); // unchanged result
+                auto t3 = std::chrono::steady_clock::now();
+                treal += std::chrono::duration<double,std::micro>(t1-t0).count() / (nsample*nrepeat);
+                trecip += std::chrono::duration<double,std::micro>(t2-t1).count() / (nsample*nrepeat)
+                  + std::chrono::duration<double,std::micro>(t3-t2).count() / (update_frequency*nrepeat);
+              }
+              volatile double sink = sum; // keep timed loops
+              (void) sink;
+              if (treal + trecip < best) {
+                best = treal + trecip;
+                best_alpha = alpha;
+                best_rc = rc;
+                best_kcc = kcc;
+                time_real = treal;
+                time_reciprocal = trecip;
+              }
+            }
+            setParameters(best_alpha, best_rc, best_kcc);
+          }
+
           string _info() override {
 	    // Estimate the real number of wave-functions used, i.e. also those who by symmetry is implicitly accounted for
 	    int realKvectors = 0;
@@ -448,6 +644,11 @@ namespace Faunus {
 	    }
             o << pad(SUB,w, "alpha") << parameters.alpha << endl;
             o << pad(SUB,w, "Real cut-off") << parameters.rc << endl;
+            if (time_real > 0) {
+              o << pad(SUB,w, "Auto-tuned, delta") << delta << endl;
+              o << pad(SUB,w, "    Real time") << time_real << " us/particle" << endl;
+              o << pad(SUB,w, "    Reciprocal time") << time_reciprocal << " us/particle" << endl;
+            }
             if(const_inf < 0.5) {
               o << pad(SUB,w+1, epsilon_m+"(Surface)") << infinity << endl;
             } else {
@@ -473,6 +674,25 @@ namespace Faunus {
         public:
           MeanValue<double> selfEnergyAverage, surfaceEnergyAverage, realEnergyAverage, reciprocalEnergyAverage;
 
+          /** @brief Ewald parameters and, if auto-tuned, measured kernel timings as JSON object */
+          Tmjson json() const override {
+            Tmjson j;
+            auto &_j = j["ewald"];
+            _j = {
+              {"alpha", parameters.alpha},
+              {"cutoff", parameters.rc},
+              {"cutoffK", parameters.kcc},
+              {"kvectors", kVectorsInUse},
+              {"drift", update_drift}
+            };
+            if (time_real > 0) {
+              _j["delta"] = delta;
+              _j["time real/us"] = time_real;
+              _j["time reciprocal/us"] = time_reciprocal;
+            }
+            return j;
+          }
+
           NonbondedEwald(Tmjson &j, const string &sec="nonbonded") : Tbase(j,sec) , selfEnergyAverage(j["energy"]["nonbonded"]["avg_block"] | 100) ,surfaceEnergyAverage(j["energy"]["nonbonded"]["avg_block"] | 100) , realEnergyAverage(j["energy"]["nonbonded"]["avg_block"] | 100) , reciprocalEnergyAverage(j["energy"]["nonbonded"]["avg_block"] | 100)  {
 	    Tbase::name += " (Ewald)";
             auto _j = j["energy"]["nonbonded"]["ewald"];
@@ -483,55 +703,51 @@ namespace Faunus {
             const_inf = (eps_surf < 1) ? 0.0 : 1.0;                 // if the value is unphysical (< 1) then we set infinity as the dielectric sonatant of the surronding medium
             spherical_sum = ( _j.value("spherical_sum",true) );     // specifies if Spherical or Cubical summation should be used in reciprocal space
 	    update_frequency = ( _j.value("update_frequency",-1) );
-	    parameters.alpha = ( _j.at("alpha") );
+            autotune = ( _j.value("autotune",false) );
+            delta = ( _j.value("delta",5e-5) );
+            time_real = time_reciprocal = 0.0;
+	    parameters.alpha = autotune ? _j.value("alpha",0.3) : _j.at("alpha").get<double>();       // starting guesses if tuned
 	    parameters.alpha2 = parameters.alpha*parameters.alpha;
-	    parameters.rc = ( _j.at("cutoff") );
-	    parameters.kc = ( _j.at("cutoffK") );
+	    parameters.rc = autotune ? _j.value("cutoff",10.0) : _j.at("cutoff").get<double>();
+	    parameters.kc = autotune ? _j.value("cutoffK",5.0) : _j.at("cutoffK").get<double>();
             parameters.kc2 = parameters.kc*parameters.kc;
             parameters.kcc = ceil(parameters.kc);
             isotropic_pbc = ( _j.value("isotropic_pbc",false) );
-	    Tbase::pairpot.first.updateRcut(parameters.rc);
-            Tbase::pairpot.first.updateAlpha(parameters.alpha);
-	    kVectorChange(kVectors,Aks,Q_ion_tot,Q_dip_tot,kVectorsInUse,parameters);
+	    Tbase::pairpot.first.update(parameters.alpha, parameters.rc);
+	    kVectorChange(kVectors,kIndices,Aks,Q_ion_tot,Q_dip_tot,kVectorsInUse,parameters);
           }
           
           /**
 	   * @brief Replaces all trial-entities with the old ones
+	   * @param geometry If false, k-vectors and their prefactors are assumed unchanged and are not copied
 	   */
-          void undo() {
+          void undo(bool geometry=true) {
 	    V_trial = V;
 	    kVectorsInUse_trial = kVectorsInUse;
 	    surfaceEnergyTrial = surfaceEnergy;
 	    reciprocalEnergyTrial = reciprocalEnergy;
-            Q_ion_tot_trial.resize(kVectorsInUse);
-            Q_dip_tot_trial.resize(kVectorsInUse);
-            kVectors_trial.resize(3, kVectorsInUse); 
-	    Aks_trial.resize(kVectorsInUse); 
-            for (int k=0; k < kVectorsInUse; k++) {
-              Q_ion_tot_trial.at(k) = Q_ion_tot.at(k);
-              Q_dip_tot_trial.at(k) = Q_dip_tot.at(k);
-              kVectors_trial.col(k) = kVectors.col(k);
-              Aks_trial[k] = Aks[k];
+            Q_ion_tot_trial = Q_ion_tot;
+            Q_dip_tot_trial = Q_dip_tot;
+            if (geometry) {
+              kVectors_trial = kVectors;
+              Aks_trial = Aks;
             }
 	  }
 	  
           /**
 	   * @brief Replaces all old-entities with the trial ones
+	   * @param geometry If false, k-vectors and their prefactors are assumed unchanged and are not copied
 	   */
-          void accept() {
+          void accept(bool geometry=true) {
 	    V = V_trial;
 	    kVectorsInUse = kVectorsInUse_trial;
 	    surfaceEnergy = surfaceEnergyTrial;
 	    reciprocalEnergy = reciprocalEnergyTrial;
-            Q_ion_tot.resize(kVectorsInUse);
-            Q_dip_tot.resize(kVectorsInUse);
-            kVectors.resize(3, kVectorsInUse);
-	    Aks.resize(kVectorsInUse); 
-            for (int k=0; k < kVectorsInUse; k++) {
-              Q_ion_tot.at(k) = Q_ion_tot_trial.at(k);
-              Q_dip_tot.at(k) = Q_dip_tot_trial.at(k);
-              kVectors.col(k) = kVectors_trial.col(k);
-              Aks[k] = Aks_trial[k];
+            Q_ion_tot = Q_ion_tot_trial;
+            Q_dip_tot = Q_dip_tot_trial;
+            if (geometry) {
+              kVectors = kVectors_trial;
+              Aks = Aks_trial;
             }
 	  }
 
@@ -547,7 +763,7 @@ namespace Faunus {
 	    assert(!change.empty() && "Change object is empty!");
             if (!move_accepted ) {
 	      // Move has been declined
-	      undo();
+	      undo(change.geometryChange);
 	      Group g(0, spc->p.size()-1);
 	      selfEnergyAverage += getSelfEnergy(spc->p,g,parameters);
 	      surfaceEnergyAverage += surfaceEnergy;
@@ -567,13 +783,13 @@ namespace Faunus {
 	      double duB = getReciprocalEnergy(Q_ion_tot_trial,Q_dip_tot_trial,Aks_trial,V_trial);                        // Calulate with old vectors/matrices
 	      updateAllComplexNumbers(spc->trial, Q_ion_tot_trial, Q_dip_tot_trial, kVectors_trial, kVectorsInUse_trial); // Re-calculate the vectors/matrices
 	      double duA = getReciprocalEnergy(Q_ion_tot_trial,Q_dip_tot_trial,Aks_trial,V_trial);                        // Calulate with new vectors/matrices
-	      accept(); 
+	      accept(change.geometryChange);
 	      cnt_accepted = 0;
 	      update_drift += fabs(duA - duB);
 	      change.clear();
 	      return (duA - duB);
 	    }
-	    accept();
+	    accept(change.geometryChange);
 	    change.clear();
 	    return 0.0;
           }
@@ -584,55 +800,35 @@ namespace Faunus {
           double updateChange(const typename Tspace::Change &c) override {
             change = c;
 
-            if(c.geometryChange) {
+            if(c.geometryChange || !c.inGroup.empty() || !c.rmGroup.empty()) {
               updateAllComplexNumbers(spc->trial, Q_ion_tot_trial, Q_dip_tot_trial,kVectors_trial,kVectorsInUse_trial);
               V_trial = V + c.dV;
 	      parameters.update(spc->geo_trial.len);
               return 0.0;
             }
 
-            // If the volume has not changed
+            // If the volume has not changed only the moved particles contribute to the change
+            moved.clear();
+            for (auto &m : change.mvGroup) {
+              if (m.second.empty())
+                for (auto i : *spc->groupList().at(m.first))
+                  moved.push_back(i);
+              else
+                moved.insert(moved.end(), m.second.begin(), m.second.end());
+            }
+
             for (int k=0; k<kVectorsInUse_trial; k++) {
               complex<double> Q2_ion = Q_ion_tot.at(k);
               complex<double> Q2_dip = Q_dip_tot.at(k);
-              for (auto m : change.mvGroup) {
-                for (auto i : m.second) {
-                  double dotTrial = kVectors_trial.col(k).dot(spc->trial[i]);
-                  double dot = kVectors.col(k).dot(spc->p[i]);
-                  if ( ( useIonIon || useIonDipole ) && !isotropic_pbc ) {
-                    Q2_ion += spc->trial[i].charge * complex<double>(cos(dotTrial),sin(dotTrial));
-                    Q2_ion -= spc->p[i].charge * complex<double>(cos(dot),sin(dot));
-                  } else if( ( useIonIon || useIonDipole ) && isotropic_pbc ) {
-		    Point kv = kVectors_trial.col(k);
-		    Q2_ion += spc->trial[i].charge*cos(kv.x()*spc->trial[i].x())*cos(kv.y()*spc->trial[i].y())*cos(kv.z()*spc->trial[i].z()); 
-		    kv = kVectors.col(k);
-		    Q2_ion -= spc->p[i].charge*cos(kv.x()*spc->p[i].x())*cos(kv.y()*spc->p[i].y())*cos(kv.z()*spc->p[i].z()); 
-		  }
-                  if ( ( useDipoleDipole || useIonDipole ) && !isotropic_pbc ) {
-                    Q2_dip += kVectors_trial.col(k).dot(spc->trial[i].mu()) * spc->trial[i].muscalar() * complex<double>(-sin(dotTrial),cos(dotTrial));
-                    Q2_dip -= kVectors.col(k).dot(spc->p[i].mu()) * spc->p[i].muscalar() * complex<double>(-sin(dot),cos(dot));
-                  } else if ( ( useDipoleDipole || useIonDipole ) && isotropic_pbc ) {
-		    Point kv = kVectors_trial.col(k);
-		    double xx = spc->trial[i].x()*kv.x();
-		    double yy = spc->trial[i].y()*kv.y();
-		    double zz = spc->trial[i].z()*kv.z();
-		    double cosX = cos(xx);
-		    double cosY = cos(yy);
-		    double cosZ = cos(zz);
-		    Q2_dip += ( sin(xx)*cosY*cosZ*spc->trial[i].mu().x()*kv.x() + cosX*sin(yy)*cosZ*spc->trial[i].mu().y()*kv.y() + cosX*cosY*sin(zz)*spc->trial[i].mu().z()*kv.z() )*spc->trial[i].muscalar();
-		    kv = kVectors.col(k);
-		    xx = spc->p[i].x()*kv.x();
-		    yy = spc->p[i].y()*kv.y();
-		    zz = spc->p[i].z()*kv.z();
-		    cosX = cos(xx);
-		    cosY = cos(yy);
-		    cosZ = cos(zz);
-		    Q2_dip -= ( sin(xx)*cosY*cosZ*spc->p[i].mu().x()*kv.x() + cosX*sin(yy)*cosZ*spc->p[i].mu().y()*kv.y() + cosX*cosY*sin(zz)*spc->p[i].mu().z()*kv.z() )*spc->p[i].muscalar();
-                  }
-                }
+              complex<double> Q_old_ion(0.0,0.0), Q_old_dip(0.0,0.0);
+              Point kvTrial = kVectors_trial.col(k);
+              Point kv = kVectors.col(k);
+              for (auto i : moved) {
+                addComplexNumbers(spc->trial[i], kvTrial, Q2_ion, Q2_dip);
+                addComplexNumbers(spc->p[i], kv, Q_old_ion, Q_old_dip);
               }
-              Q_ion_tot_trial.at(k) = Q2_ion;
-              Q_dip_tot_trial.at(k) = Q2_dip;
+              Q_ion_tot_trial[k] = Q2_ion - Q_old_ion;
+              Q_dip_tot_trial[k] = Q2_dip - Q_old_dip;
             }
             return 0.0;
           }
@@ -666,11 +862,11 @@ namespace Faunus {
 	    parameters.update(g.len);
 	    if(Tbase::isGeometryTrial(g)) {
 	      V_trial = g.getVolume();
-	      kVectorChange(kVectors_trial,Aks_trial,Q_ion_tot_trial,Q_dip_tot_trial,kVectorsInUse_trial,parameters);
+	      kVectorChange(kVectors_trial,kIndices,Aks_trial,Q_ion_tot_trial,Q_dip_tot_trial,kVectorsInUse_trial,parameters);
 	      updateAllComplexNumbers(spc->trial,Q_ion_tot_trial,Q_dip_tot_trial,kVectors_trial,kVectorsInUse_trial);
 	    } else {
 	      V = g.getVolume();
-	      kVectorChange(kVectors,Aks,Q_ion_tot,Q_dip_tot,kVectorsInUse,parameters);
+	      kVectorChange(kVectors,kIndices,Aks,Q_ion_tot,Q_dip_tot,kVectorsInUse,parameters);
 	      updateAllComplexNumbers(spc->p,Q_ion_tot,Q_dip_tot,kVectors,kVectorsInUse);
 	    }
 	  }
@@ -681,6 +877,13 @@ namespace Faunus {
           void setSpace(Tspace &s) override {
             Tbase::setSpace(s);
             N = s.p.size();
+            if (update_frequency < 1)
+              update_frequency = N;
+            if (autotune && N > 0) {
+              tune();
+              autotune = false;
+              setGeometry(s.geo);
+            }
 	    Group g(0, N-1);
 	    surfaceEnergy = getSurfaceEnergy(s.p,g,V);
 	    reciprocalEnergy = getReciprocalEnergy(Q_ion_tot,Q_dip_tot,Aks,V);
@@ -689,6 +892,419 @@ namespace Faunus {
           }
       };
 
+    /**
+     * @brief Smooth particle-mesh Ewald (SPME) summation for ions
+     * @date Lund 2026
+     *
+     * Reciprocal space part of the Ewald sum evaluated on a grid as described by
+     * Essmann et al. (DOI: 10.1063/1.470117). Charges are assigned to a
+     * \f$ K_x\times K_y\times K_z \f$ grid using cardinal B-splines of order \f$ n \f$,
+     * the grid is Fourier transformed and multiplied with the influence function
+     *
+     * @f[
+     * \theta({\bf m}) = \frac{2\pi}{V} \frac{e^{-k^2/4\alpha^2}}{k^2} \prod_{d} |b_d(m_d)|^2
+     * \;\;,\;\; {\bf k} = 2\pi\left( \frac{m_x}{L_x}, \frac{m_y}{L_y}, \frac{m_z}{L_z} \right)
+     * @f]
+     *
+     * so that \f$ E_{Reciprocal} = \sum_{\bf m} \theta({\bf m}) |F(Q)({\bf m})|^2 \f$ scales as
+     * \f$ O(N + K\log K) \f$. The real space part is handled by `EwaldReal` and the self and
+     * surface terms are the same as for `NonbondedEwald`.
+     *
+     * For local moves the trial energy is found without Fourier transforms. With the grid
+     * potential \f$ \phi = F^{-1}(\theta F(Q)) \f$ and the real space kernel
+     * \f$ G = F^{-1}(\theta) \f$, a sparse change \f$ \Delta Q \f$ of the charge grid gives
+     *
+     * @f[
+     * \Delta E = 2\sum_{\bf r} \Delta Q({\bf r})\phi({\bf r}) + \sum_{{\bf r},{\bf r}'} \Delta Q({\bf r})G({\bf r}-{\bf r}')\Delta Q({\bf r}')
+     * @f]
+     *
+     * which costs \f$ O((n^3 N_{moved})^2) \f$. Accepted local changes are added to the charge
+     * grid and kept in a list of pending changes, whose potential is summed with \f$ G \f$ where
+     * needed, rather than transforming \f$ \phi \f$ anew. \f$ \phi \f$ is refreshed by FFT only when
+     * the pending list makes this cheaper, every `update_frequency` accepted moves, and after
+     * large moves. Large moves, insertions, deletions and volume changes rebuild the
+     * trial grid from scratch.
+     *
+     *  Keyword          |  Description
+     * :--------------   | :---------------
+     * `alpha`           |  Damping parameter (1/Å)
+     * `cutoff`          |  Real space cut-off (Å)
+     * `grid`            |  Number of grid points along each axis; lengths with small prime factors are fastest (Default: 32)
+     * `order`           |  Order of B-spline interpolation, \f$ 2\leq n\leq 12 \f$ (Default: 4)
+     * `eps_surf`        |  Dielectric constant of the surroundings; values below one means tinfoil (Default: tinfoil)
+     * `update_frequency`|  Number of accepted moves between full rebuilds of the charge grid (Default: Number of particles in system)
+     *
+     * Parameters are read from `energy/nonbonded/spme`. Only ion-ion interactions in
+     * cuboidal geometries are supported.
+     */
+    template<
+      class Tspace, \
+      class Tpairpot, \
+      class Tbase=NonbondedVector<Tspace, \
+      CombinedPairPotential<EwaldReal<true,false,false>, Tpairpot>>>
+
+      class NonbondedSPME : public Tbase {
+        private:
+          using Tbase::spc;
+          typedef typename Tbase::Tparticle Tparticle;
+          typedef typename Tbase::Tpvec Tpvec;
+
+          struct GridCharge {
+            int x, y, z;  // grid point
+            double q;     // charge assigned to grid point
+          };
+
+          int K[3], Ktot, order, N, cnt_accepted, update_frequency;
+          double alpha, lB, eps_surf, const_inf, V, V_trial, update_drift;
+          double surfaceEnergy, surfaceEnergyTrial, reciprocalEnergy, reciprocalEnergyTrial;
+          bool fullTrial; // true if the trial grid was rebuilt rather than updated by 'delta'
+          typename Tspace::Change change;
+
+          vector<double> Q, Q_trial;         // charge grids
+          vector<double> phi;                // grid potential of accepted charges
+          vector<double> theta, theta_trial; // influence functions
+          vector<double> G, G_trial;         // real space influence functions
+          vector<complex<double>> work;
+          vector<GridCharge> delta;          // sparse charge grid change for local moves
+          vector<GridCharge> pending;        // accepted changes in Q not yet included in phi
+          vector<int> moved;
+          FFT3D fft;
+
+          enum {maxorder=12};
+
+          int index(int x, int y, int z) const { return (x*K[1] + y)*K[2] + z; }
+
+          /**
+           * @brief Cardinal B-spline weights \f$ M_n(w+j) \f$ for \f$ j=0\ldots n-1 \f$, \f$ 0\leq w<1 \f$
+           */
+          void bspline(double w, double *M) const {
+            M[0] = w;
+            M[1] = 1 - w;
+            for (int k=3; k<=order; k++) {
+              M[k-1] = 0;
+              for (int j=k-1; j>=0; j--)
+                M[j] = ( (w+j)*M[j] + (j>0 ? (k-w-j)*M[j-1] : 0) ) / (k-1);
+            }
+          }
+
+          /**
+           * @brief Spread a point charge onto grid points, calling `f(x,y,z,q)` for each
+           */
+          template<class Tfunc>
+            void assign(const Point &a, double q, const Point &L, Tfunc f) const {
+              double M[3][maxorder];
+              int first[3];
+              for (int d=0; d<3; d++) {
+                double u = K[d] * (a[d]/L[d] + 0.5);
+                double fl = std::floor(u);
+                bspline(u - fl, M[d]);
+                first[d] = int(fl) % K[d];
+                if (first[d] < 0)
+                  first[d] += K[d];
+              }
+              for (int i=0; i<order; i++) {
+                int x = first[0] - i;
+                if (x < 0) x += K[0];
+                double qx = q * M[0][i];
+                for (int j=0; j<order; j++) {
+                  int y = first[1] - j;
+                  if (y < 0) y += K[1];
+                  double qxy = qx * M[1][j];
+                  for (int k=0; k<order; k++) {
+                    int z = first[2] - k;
+                    if (z < 0) z += K[2];
+                    f(x, y, z, qxy * M[2][k]);
+                  }
+                }
+              }
+            }
+
+          void buildGrid(const Tpvec &p, const Point &L, vector<double> &grid) const {
+            grid.assign(Ktot, 0.0);
+            for (auto &a : p)
+              if (a.charge != 0)
+                assign(a, a.charge, L, [&](int x, int y, int z, double q) { grid[index(x,y,z)] += q; });
+          }
+
+          /**
+           * @brief Influence function and its real space counterpart for box side lengths `L`
+           */
+          void influence(const Point &L, vector<double> &th, vector<double> &g) {
+            double volume = L.x()*L.y()*L.z();
+            vector<double> bsp[3]; // squared B-spline moduli
+            vector<double> M(order);
+            bspline(0.0, &M[0]);   // M[j] = M_n(j)
+            for (int d=0; d<3; d++) {
+              bsp[d].resize(K[d]);
+              for (int m=0; m<K[d]; m++) {
+                complex<double> s(0,0);
+                for (int k=0; k<order-1; k++)
+                  s += M[k+1] * std::polar(1.0, 2*pc::pi*m*k/K[d]);
+                bsp[d][m] = (std::norm(s) < 1e-10) ? 0.0 : 1.0/std::norm(s);
+              }
+            }
+            th.resize(Ktot);
+            for (int x=0; x<K[0]; x++) {
+              double kx = 2*pc::pi*((x <= K[0]/2) ? x : x-K[0]) / L.x();
+              for (int y=0; y<K[1]; y++) {
+                double ky = 2*pc::pi*((y <= K[1]/2) ? y : y-K[1]) / L.y();
+                for (int z=0; z<K[2]; z++) {
+                  double kz = 2*pc::pi*((z <= K[2]/2) ? z : z-K[2]) / L.z();
+                  double k2 = kx*kx + ky*ky + kz*kz;
+                  th[index(x,y,z)] = (k2 > 0) ?
+                    lB * (2*pc::pi/volume) * exp(-k2/(4*alpha*alpha)) / k2 * bsp[0][x]*bsp[1][y]*bsp[2][z] : 0.0;
+                }
+              }
+            }
+            work.assign(th.begin(), th.end());
+            fft.backward(work);
+            g.resize(Ktot);
+            for (int i=0; i<Ktot; i++)
+              g[i] = work[i].real();
+          }
+
+          /**
+           * @brief Reciprocal energy of a charge grid. If given, the grid potential is stored in `pot`.
+           */
+          double gridEnergy(const vector<double> &grid, const vector<double> &th, vector<double> *pot=nullptr) {
+            work.assign(grid.begin(), grid.end());
+            fft.forward(work);
+            double E = 0;
+            for (int i=0; i<Ktot; i++) {
+              E += th[i] * std::norm(work[i]);
+              work[i] *= th[i];
+            }
+            if (pot != nullptr) {
+              fft.backward(work);
+              pot->resize(Ktot);
+              for (int i=0; i<Ktot; i++)
+                (*pot)[i] = work[i].real();
+            }
+            return E;
+          }
+
+          /** @brief Cost estimate of a grid transform used to choose between sparse and full updates */
+          double transformCost() const { return 10*Ktot*std::log2(Ktot); }
+
+          /** @brief Grid potential at a grid point, including pending changes */
+          double potential(const GridCharge &a) const {
+            double s = phi[index(a.x,a.y,a.z)];
+            for (auto &b : pending) {
+              int x = a.x-b.x, y = a.y-b.y, z = a.z-b.z;
+              if (x < 0) x += K[0];
+              if (y < 0) y += K[1];
+              if (z < 0) z += K[2];
+              s += G[index(x,y,z)] * b.q;
+            }
+            return s;
+          }
+
+          template<class Tgroup>
+            double getSelfEnergy(const Tpvec &p, const Tgroup &g) const {
+              double Eq = 0;
+              for (auto i : g)
+                Eq += p[i].charge * p[i].charge;
+              return -alpha * Eq / sqrt(pc::pi) * lB;
+            }
+
+          double getSurfaceEnergy(const Tpvec &p, double V_in) const {
+            if (const_inf < 0.5)
+              return 0.0;
+            Point qrs(0,0,0);
+            for (auto &a : p)
+              qrs += a.charge * a;
+            return const_inf * (2*pc::pi/((2*eps_surf + 1)*V_in)) * qrs.dot(qrs) * lB;
+          }
+
+          string _info() override {
+            using namespace Faunus::textio;
+            char w=25;
+            std::ostringstream o;
+            o << Tbase::_info();
+            o << header("Smooth particle-mesh Ewald");
+            o << pad(SUB,w,"Grid") << K[0] << "x" << K[1] << "x" << K[2] << endl
+              << pad(SUB,w,"B-spline order") << order << endl
+              << pad(SUB,w,"alpha") << alpha << _angstrom+"^-1" << endl
+              << pad(SUB,w,"Surface dielectric") << ((const_inf < 0.5) ? string("tinfoil") : std::to_string(eps_surf)) << endl
+              << pad(SUB,w,"Update frequency") << update_frequency << endl
+              << pad(SUB,w,"Update drift") << update_drift << kT << endl;
+            return o.str();
+          }
+
+        public:
+          NonbondedSPME(Tmjson &j) : Tbase(j) {
+            Tbase::name += " (SPME)";
+            auto _j = j["energy"]["nonbonded"]["spme"];
+            alpha = _j.at("alpha");
+            order = _j.value("order", 4);
+            K[0] = K[1] = K[2] = _j.value("grid", 32);
+            eps_surf = _j.value("eps_surf", 0.0);
+            const_inf = (eps_surf < 1) ? 0.0 : 1.0;
+            update_frequency = _j.value("update_frequency", -1);
+            if (order < 2 || order > maxorder || order > K[0])
+              throw std::runtime_error("SPME: B-spline order must be in the range [2,min(grid,12)]");
+            Ktot = K[0]*K[1]*K[2];
+            fft.resize(K[0], K[1], K[2]);
+            lB = Tbase::pairpot.first.bjerrumLength();
+            double rc = _j.at("cutoff");
+            Tbase::pairpot.first.update(alpha, rc);
+            cnt_accepted = 0;
+            update_drift = 0;
+            fullTrial = false;
+          }
+
+          /**
+           * @brief Set space and rebuild the charge grid
+           */
+          void setSpace(Tspace &s) override {
+            Tbase::setSpace(s);
+            N = s.p.size();
+            if (update_frequency < 1)
+              update_frequency = N;
+            Point L = s.geo.len;
+            V = V_trial = s.geo.getVolume();
+            influence(L, theta, G);
+            buildGrid(s.p, L, Q);
+            reciprocalEnergy = reciprocalEnergyTrial = gridEnergy(Q, theta, &phi);
+            pending.clear();
+            surfaceEnergy = surfaceEnergyTrial = getSurfaceEnergy(s.p, V);
+          }
+
+          /** @brief Prepare trial reciprocal energy due to Change */
+          double updateChange(const typename Tspace::Change &c) override {
+            change = c;
+            auto &geo = c.geometryChange ? spc->geo_trial : spc->geo;
+            Point L = geo.len;
+            if (c.geometryChange || !c.inGroup.empty() || !c.rmGroup.empty()) {
+              fullTrial = true;
+              V_trial = geo.getVolume();
+              if (c.geometryChange)
+                influence(L, theta_trial, G_trial);
+              buildGrid(spc->trial, L, Q_trial);
+              reciprocalEnergyTrial = gridEnergy(Q_trial, c.geometryChange ? theta_trial : theta);
+              return 0.0;
+            }
+
+            moved.clear();
+            for (auto &m : c.mvGroup) {
+              if (m.second.empty())
+                for (auto i : *spc->groupList().at(m.first))
+                  moved.push_back(i);
+              else
+                moved.insert(moved.end(), m.second.begin(), m.second.end());
+            }
+
+            delta.clear();
+            auto add = [&](int x, int y, int z, double q) { delta.push_back({x,y,z,q}); };
+            for (auto i : moved) {
+              if (spc->trial[i].charge != 0)
+                assign(spc->trial[i], spc->trial[i].charge, L, add);
+              if (spc->p[i].charge != 0)
+                assign(spc->p[i], -spc->p[i].charge, L, add);
+            }
+
+            // for many moved charges a full transform is cheaper than the pair sum
+            double nd = delta.size();
+            fullTrial = ( nd*(nd + pending.size()) > transformCost() );
+            if (fullTrial) {
+              Q_trial = Q;
+              for (auto &a : delta)
+                Q_trial[index(a.x,a.y,a.z)] += a.q;
+              reciprocalEnergyTrial = gridEnergy(Q_trial, theta);
+              return 0.0;
+            }
+
+            double du = 0;
+            for (auto &a : delta) {
+              double s = 2*potential(a);
+              for (auto &b : delta) {
+                int x = a.x-b.x, y = a.y-b.y, z = a.z-b.z;
+                if (x < 0) x += K[0];
+                if (y < 0) y += K[1];
+                if (z < 0) z += K[2];
+                s += G[index(x,y,z)] * b.q;
+              }
+              du += a.q * s;
+            }
+            reciprocalEnergyTrial = reciprocalEnergy + du;
+            return 0.0;
+          }
+
+          /**
+           * @brief Update charge grid if a move has been accepted
+           *
+           * Local changes are appended to the pending list. The grid potential is
+           * refreshed by a transform after large moves, every `update_frequency`
+           * accepted moves, and when summing over the pending list for a move of
+           * the same size would cost more than a transform.
+           *
+           * @return Drift in reciprocal energy found when the grid potential is refreshed
+           */
+          double update(bool move_accepted) override {
+            if (!move_accepted) {
+              V_trial = V;
+              reciprocalEnergyTrial = reciprocalEnergy;
+              surfaceEnergyTrial = surfaceEnergy;
+              change.clear();
+              return 0.0;
+            }
+            if (change.geometryChange) {
+              theta.swap(theta_trial);
+              G.swap(G_trial);
+            }
+            V = V_trial;
+            bool refresh = fullTrial;
+            if (fullTrial)
+              Q.swap(Q_trial);
+            else {
+              for (auto &a : delta)
+                Q[index(a.x,a.y,a.z)] += a.q;
+              pending.insert(pending.end(), delta.begin(), delta.end());
+              refresh = ( double(delta.size())*(delta.size() + pending.size()) > transformCost() );
+            }
+            if (++cnt_accepted >= update_frequency) {
+              buildGrid(spc->trial, (change.geometryChange ? spc->geo_trial : spc->geo).len, Q);
+              cnt_accepted = 0;
+              refresh = true;
+            }
+            double drift = 0;
+            if (refresh) {
+              reciprocalEnergy = gridEnergy(Q, theta, &phi);
+              pending.clear();
+              drift = reciprocalEnergy - reciprocalEnergyTrial;
+              update_drift += fabs(drift);
+            }
+            else
+              reciprocalEnergy = reciprocalEnergyTrial;
+            surfaceEnergy = surfaceEnergyTrial;
+            reciprocalEnergyTrial = reciprocalEnergy;
+            delta.clear();
+            change.clear();
+            return drift;
+          }
+
+          double i_external(const Tpvec &p, int i) override {
+            Group g(i,i);
+            return g_external(p,g);
+          }
+
+          double g_external(const Tpvec &p, Group &g) override {
+            return getSelfEnergy(p,g);
+          }
+
+          double external(const Tpvec &p) override {
+            if (Tbase::isTrial(p)) {
+              surfaceEnergyTrial = getSurfaceEnergy(p,V_trial);
+              return surfaceEnergyTrial + reciprocalEnergyTrial;
+            }
+            surfaceEnergy = getSurfaceEnergy(p,V);
+            return surfaceEnergy + reciprocalEnergy;
+          }
+
+          /** @brief Reciprocal energy of the accepted configuration (kT) */
+          double reciprocal() const { return reciprocalEnergy; }
+      };
+
   }//namespace
 }//namespace
 #endif
@@ -0,0 +1,194 @@
+#ifndef FAUNUS_FFT_H
+#define FAUNUS_FFT_H
+
+#ifndef SWIG
+#include <complex>
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#endif
+
+namespace Faunus {
+
+  /**
+   * @brief Mixed-radix complex fast Fourier transform of fixed length
+   *
+   * The length is factorised and the transform is carried out by recursive
+   * Cooley-Tukey decimation in time with radix-4 and radix-2 butterflies and a
+   * direct DFT for any remaining prime factor. Any length is accepted, but
+   * lengths with only small prime factors (2, 3, 5) are much faster. Both
+   * directions are unnormalised,
+   *
+   * @f[
+   * X_k = \sum_{j=0}^{n-1} x_j e^{\mp 2\pi i jk/n}
+   * @f]
+   *
+   * where the minus sign is used for the forward transform.
+   *
+   * Example:
+   *
+   *     FFT fft(12);
+   *     std::vector<std::complex<double>> x(12), X(12);
+   *     fft.forward(x.data(), X.data());
+   *     fft.backward(X.data(), x.data()); // x is now scaled by 12
+   */
+  class FFT {
+    private:
+      typedef std::complex<double> Tcomplex;
+      int n;
+      std::vector<int> factors;
+      std::vector<Tcomplex> twiddle, twiddle_inv; // exp(-2*pi*i*j/n) and its conjugate
+      std::vector<Tcomplex> scratch;
+
+      /** @brief Complex product without the NaN/Inf recovery of `std::complex` operator* */
+      static Tcomplex mul(const Tcomplex &a, const Tcomplex &b) {
+        return Tcomplex(a.real()*b.real() - a.imag()*b.imag(), a.real()*b.imag() + a.imag()*b.real());
+      }
+
+      void transform(const Tcomplex *in, Tcomplex *out, int len, int stride, int level, bool inverse) {
+        const int p = factors[level];
+        const int m = len / p;
+        const int tstride = n / len;
+        const Tcomplex *w = inverse ? &twiddle_inv[0] : &twiddle[0];
+        if (m == 1)
+          for (int q=0; q<p; q++)
+            out[q] = in[q*stride];
+        else
+          for (int q=0; q<p; q++)
+            transform(in + q*stride, out + q*m, m, stride*p, level+1, inverse);
+
+        if (p == 2) {
+          for (int k=0; k<m; k++) {
+            Tcomplex a = out[k], b = mul(out[k+m], w[k*tstride]);
+            out[k] = a + b;
+            out[k+m] = a - b;
+          }
+        }
+        else if (p == 4) {
+          for (int k=0; k<m; k++) {
+            Tcomplex a0 = out[k];
+            Tcomplex a1 = mul(out[k+m], w[k*tstride]);
+            Tcomplex a2 = mul(out[k+2*m], w[2*k*tstride]);
+            Tcomplex a3 = mul(out[k+3*m], w[3*k*tstride]);
+            Tcomplex s02 = a0 + a2, d02 = a0 - a2, s13 = a1 + a3, d13 = inverse ? Tcomplex(a3.imag()-a1.imag(), a1.real()-a3.real()) : Tcomplex(a1.imag()-a3.imag(), a3.real()-a1.real()); // -/+ i*(a1-a3)
+            out[k] = s02 + s13;
+            out[k+m] = d02 + d13;
+            out[k+2*m] = s02 - s13;
+            out[k+3*m] = d02 - d13;
+          }
+        }
+        else { // generic radix: direct DFT of length p
+          Tcomplex *t = &scratch[0];
+          const int pstride = n / p;
+          for (int k=0; k<m; k++) {
+            for (int q=0; q<p; q++)
+              t[q] = mul(out[q*m + k], w[q*k*tstride]);
+            for (int r=0; r<p; r++) {
+              Tcomplex s = t[0];
+              for (int q=1; q<p; q++)
+                s += mul(t[q], w[((q*r) % p) * pstride]);
+              out[k + r*m] = s;
+            }
+          }
+        }
+      }
+
+    public:
+      FFT(int len=1) { resize(len); }
+
+      /** @brief Set transform length and precompute twiddle factors */
+      void resize(int len) {
+        if (len < 1)
+          throw std::runtime_error("FFT length must be positive");
+        n = len;
+        factors.clear();
+        int maxfactor = 1;
+        for (int f=4, r=n; r>1; ) { // trial factors 4, 2, 3, 5, 7, ...
+          if (f*f > r && f > 4)
+            f = r;                     // remainder is prime
+          if (r % f == 0) {
+            factors.push_back(f);
+            maxfactor = std::max(maxfactor, f);
+            r /= f;
+          } else if (f == 4)
+            f = 2;
+          else
+            f = (f == 2) ? 3 : f+2;
+        }
+        if (factors.empty())
+          factors.push_back(1);
+        twiddle.resize(n);
+        twiddle_inv.resize(n);
+        for (int j=0; j<n; j++) {
+          twiddle[j] = std::polar(1.0, -2*std::acos(-1.0)*j/n);
+          twiddle_inv[j] = std::conj(twiddle[j]);
+        }
+        scratch.resize(maxfactor);
+      }
+
+      int size() const { return n; }
+
+      /** @brief Forward transform; `in` and `out` must not overlap */
+      void forward(const Tcomplex *in, Tcomplex *out) { transform(in, out, n, 1, 0, false); }
+
+      /** @brief Backward (inverse, unnormalised) transform; `in` and `out` must not overlap */
+      void backward(const Tcomplex *in, Tcomplex *out) { transform(in, out, n, 1, 0, true); }
+  };
+
+  /**
+   * @brief Three dimensional complex FFT on a row-major grid
+   *
+   * The grid element \f$ (x,y,z) \f$ is stored at index \f$ (xK_y + y)K_z + z \f$.
+   * The transform is done as one dimensional transforms along each axis.
+   */
+  class FFT3D {
+    private:
+      typedef std::complex<double> Tcomplex;
+      int K[3];
+      FFT fft[3];
+      std::vector<Tcomplex> line_in, line_out;
+
+      void transform(std::vector<Tcomplex> &data, bool inverse) {
+        const int stride[3] = { K[1]*K[2], K[2], 1 };
+        for (int d=0; d<3; d++) {
+          const int a = (d+1) % 3, b = (d+2) % 3; // the two other axes
+          for (int i=0; i<K[a]; i++)
+            for (int j=0; j<K[b]; j++) {
+              Tcomplex *base = &data[i*stride[a] + j*stride[b]];
+              for (int l=0; l<K[d]; l++)
+                line_in[l] = base[l*stride[d]];
+              if (inverse)
+                fft[d].backward(&line_in[0], &line_out[0]);
+              else
+                fft[d].forward(&line_in[0], &line_out[0]);
+              for (int l=0; l<K[d]; l++)
+                base[l*stride[d]] = line_out[l];
+            }
+        }
+      }
+
+    public:
+      FFT3D(int kx=1, int ky=1, int kz=1) { resize(kx, ky, kz); }
+
+      void resize(int kx, int ky, int kz) {
+        K[0] = kx;
+        K[1] = ky;
+        K[2] = kz;
+        for (int d=0; d<3; d++)
+          fft[d].resize(K[d]);
+        line_in.resize(std::max(kx, std::max(ky, kz)));
+        line_out.resize(line_in.size());
+      }
+
+      /** @brief Total number of grid points */
+      int size() const { return K[0]*K[1]*K[2]; }
+
+      /** @brief In-place forward transform */
+      void forward(std::vector<Tcomplex> &data) { transform(data, false); }
+
+      /** @brief In-place backward (inverse, unnormalised) transform */
+      void backward(std::vector<Tcomplex> &data) { transform(data, true); }
+  };
+
+}//namespace
+#endif
@@ -72,6 +72,7 @@ namespace Faunus
         virtual void randompos( Point & )=0;              //!< Random point within container
         virtual void boundary( Point & ) const =0;             //!< Apply boundary conditions to a point
         virtual void scale( Point &, Point &, const double, const double ) const;  //!< Scale point
+        double isotropicScale( Point &, const double, const double ) const;  //!< Linear factor of `scale()` if isotropic, else zero
         virtual double sqdist( const Point &a, const Point &b ) const =0; //!< Squared distance between two points
         virtual Point vdist( const Point &, const Point & )=0;  //!< Distance in vector form
 
@@ -410,6 +411,41 @@ namespace Faunus
         }
     };
 
+    /**
+     * @brief Squared distances between a point and a range of positions
+     * @param geo Geometry
+     * @param a Point
+     * @param b Structure of arrays with positions `x`, `y`, and `z` (see `ParticleArrays`)
+     * @param first First index in `b`
+     * @param last One beyond last index in `b`
+     * @param r2 Output; `r2[j-first]` is the squared distance to position `j`
+     */
+    template<class Tgeometry, class Tarrays>
+    void sqdist( const Tgeometry &geo, const Point &a, const Tarrays &b, int first, int last, double *r2 )
+    {
+        for ( int j = first; j < last; j++ )
+            r2[j - first] = geo.sqdist(a, Point(b.x[j], b.y[j], b.z[j]));
+    }
+
+    /** @brief Squared distances in periodic cuboid, written for auto-vectorization */
+    template<class Tarrays>
+    void sqdist( const Cuboid &geo, const Point &a, const Tarrays &b, int first, int last, double *r2 )
+    {
+        double lx = geo.len.x(), ly = geo.len.y(), lz = geo.len.z();
+        double ix = 1 / lx, iy = 1 / ly, iz = 1 / lz;
+        const double *x = b.x.data(), *y = b.y.data(), *z = b.z.data();
+        for ( int j = first; j < last; j++ )
+        {
+            double dx = x[j] - a.x();
+            double dy = y[j] - a.y();
+            double dz = z[j] - a.z();
+            dx -= lx * std::floor(dx * ix + 0.5);
+            dy -= ly * std::floor(dy * iy + 0.5);
+            dz -= lz * std::floor(dz * iz + 0.5);
+            r2[j - first] = dx * dx + dy * dy + dz * dz;
+        }
+    }
+
     /**
      * @brief Calculate center of cluster of particles
      * @param geo Geometry
@@ -10,6 +10,7 @@
 #include <faunus/textio.h>
 #include <faunus/geometry.h>
 #include <faunus/energy.h>
+#include <faunus/celllist.h>
 #include <faunus/textio.h>
 #include <faunus/json.h>
 #include <faunus/titrate.h>
@@ -55,6 +56,9 @@ namespace Faunus
 						accmap[k] += 0;
 					}
 
+					/** @brief Sum of squared displacements of accepted moves */
+					double msqsum( Tkey k ) { return sqrmap[k].sum; }
+
 					string info( char l = 10 )
 					{
 						using namespace textio;
@@ -272,7 +276,6 @@ namespace Faunus
 			{
 				private:
 					unsigned long int cnt_accepted;  //!< number of accepted moves
-					double dusum;                    //!< Sum of all energy changes
 
 					virtual void _test( UnitTest & );   //!< Unit testing
 					virtual void _trialMove()=0;     //!< Do a trial move
@@ -280,17 +283,47 @@ namespace Faunus
 					virtual void _rejectMove()=0;    //!< Reject move and config
 					virtual double _energyChange()=0;//!< Energy change of move (kT)
 
+					/** @brief Information as JSON object */
+					virtual Tmjson _json() { return Tmjson(); }
+
+					struct TuneData
+					{
+						double msq;    // accumulated squared displacement at start of block
+						double rate;   // running average of squared displacement per microsecond
+						double factor; // multiplicative step
+						int sign;      // direction of step (+1 or -1)
+						TuneData() : msq(0), rate(-1), factor(1.5), sign(1) {}
+					};
+
+					unsigned long tunesteps;         //!< Remaining calls to move() with tuning
+					unsigned long tuneinterval;      //!< Calls to move() per tuning block
+					unsigned long tunecnt;           //!< Calls to move() in current block
+					unsigned long tunetrials;        //!< Trial count at start of block
+					unsigned long tuneaccepted;      //!< Accepted count at start of block
+					double tunetime;                 //!< Timer value at start of block
+					std::map<string, TuneData> tunedata;
+
+				protected:
+					double dusum;                    //!< Sum of all energy changes
+					TimeRelativeOfTotal<std::chrono::nanoseconds> timer; // ns as single moves may be sub-microsecond
+
+					struct Tunable
+					{
+						string name;                 //!< Name in JSON output
+						double *value;               //!< Displacement parameter
+						std::function<double()> msq; //!< Accumulated squared displacement of accepted moves
+					};
+
+					/** @brief Displacement parameters that can be tuned */
+					virtual std::vector<Tunable> _tunables() { return {}; }
+
+					void tune();                     //!< Displacement tuning step; call at end of move()
+
 					void acceptMove();               //!< Accept move (wrapper)
 					void rejectMove();               //!< Reject move (wrapper)
 					double energyChange();           //!< Energy (wrapper)
 					bool metropolis( const double & ) const;//!< Metropolis criteria
 
-					TimeRelativeOfTotal<std::chrono::microseconds> timer;
-
-					/** @brief Information as JSON object */
-					virtual Tmjson _json() { return Tmjson(); }
-
-				protected:
 					virtual string _info()=0;        //!< info for derived moves
 					void trialMove();                //!< Do a trial move (wrapper)
 					Energy::Energybase<Tspace> *pot; //!< Pointer to energy functions
@@ -366,6 +399,7 @@ namespace Faunus
 					string info();                     //!< Returns information string
 					void test( UnitTest & );              //!< Perform unit test
 					double getAcceptance() const;      //!< Get acceptance [0:1]
+					void setTuning( unsigned long, unsigned long= 100 ); //!< Tune displacements during equilibration
 
 					void addMol( int, const MolListData &d = MolListData()); //!< Specify molecule id to act upon
 					Group *randomMol();
@@ -383,6 +417,9 @@ namespace Faunus
 								{"runfraction", runfraction},
 								{"relative time", timer.result()}
 							};
+							if ( !tunedata.empty())
+								for ( auto &t : _tunables())
+									j[title]["tuned"][t.name] = *t.value;
 							j = merge(j, _json());
 						}
 						return j;
@@ -406,6 +443,9 @@ namespace Faunus
 				spc = &s;
 				cnt = cnt_accepted = 0;
 				dusum = 0;
+				tunesteps = tunecnt = tunetrials = tuneaccepted = 0;
+				tuneinterval = 100;
+				tunetime = 0;
 				w = 30;
 				runfraction = 1;
 				useAlternativeReturnEnergy = false; //this has no influence on metropolis sampling!
@@ -529,6 +569,7 @@ namespace Faunus
 					while ( n-- > 0 )
 					{
 						trialMove();
+						spc->syncArrays(change);
 						pot->updateChange(change);
 
 						double du = energyChange();
@@ -543,15 +584,93 @@ namespace Faunus
 							dusum += du;
 							utot += du;
 						}
+						spc->syncArrays(change);
 						utot += pot->update(acceptance);
 						change.clear();
 					}
 				}
 				assert(spc->p == spc->trial && "Trial particle vector out of sync!");
 				timer.stop();
+				tune();
 				return utot;
 			}
 
+		/**
+		 * Displacement parameters returned by `_tunables()` are adjusted during
+		 * the next `steps` calls to `move()` whereafter they are frozen. The
+		 * calls are divided into blocks of `interval` and after each block,
+		 * every parameter is scaled by a factor in the direction that
+		 * increased its mean square displacement per CPU time, as measured by
+		 * `timer`. Blocks are extended until they span at least a millisecond
+		 * of move time, and the rate is averaged with that of the previous
+		 * block, so that timer noise does not decide the direction. When the
+		 * direction reverses, the factor is reduced (down to
+		 * 5%) so that the parameter settles around the optimum; it grows again
+		 * (up to 50%) while steps keep improving. Blocks without any accepted
+		 * move always decrease the parameters. Tuned values are reported in
+		 * `json()`.
+		 *
+		 * Tuning breaks detailed balance and must be limited to equilibration.
+		 */
+		template<class Tspace>
+			void Movebase<Tspace>::setTuning( unsigned long steps, unsigned long interval )
+			{
+				tunesteps = steps;
+				tuneinterval = std::max(1ul, interval);
+				tunecnt = 0;
+				tunetrials = cnt;
+				tuneaccepted = cnt_accepted;
+				tunetime = timer.elapsed();
+				for ( auto &t : _tunables())
+					tunedata[t.name].msq = t.msq();
+			}
+
+		template<class Tspace>
+			void Movebase<Tspace>::tune()
+			{
+				if ( tunesteps == 0 )
+					return;
+				tunesteps--;
+				if ( ++tunecnt < tuneinterval && tunesteps > 0 )
+					return;
+				double dt = (timer.elapsed() - tunetime) / 1000; // microseconds
+				bool accepted = cnt_accepted > tuneaccepted;
+				if ( cnt == tunetrials || (dt < 1000 && tunesteps > 0) || dt <= 0 )
+					return; // too little to learn from - extend block
+				tunecnt = 0;
+				tunetime = timer.elapsed();
+				tunetrials = cnt;
+				tuneaccepted = cnt_accepted;
+				for ( auto &t : _tunables())
+				{
+					auto it = tunedata.find(t.name);
+					if ( it == tunedata.end()) // appeared during tuning
+					{
+						tunedata[t.name].msq = t.msq();
+						continue;
+					}
+					auto &d = it->second;
+					double msq = t.msq();
+					double rate = (msq - d.msq) / dt;
+					if ( d.rate >= 0 )
+						rate = 0.5 * (rate + d.rate); // smooth out timer noise
+					d.msq = msq;
+					if ( *t.value < 1e-6 )
+						continue;
+					if ( !accepted )
+						d.sign = -1;
+					else if ( rate < d.rate )
+					{
+						d.sign = -d.sign;
+						d.factor = std::max(std::sqrt(d.factor), 1.05);
+					}
+					else if ( d.rate >= 0 )
+						d.factor = std::min(d.factor * d.factor, 1.5); // recover from noisy timings
+					d.rate = rate;
+					*t.value *= std::pow(d.factor, d.sign);
+				}
+			}
+
 		/**
 		 * @param du Energy change for MC move (kT)
 		 * @return True if move should be accepted; false if not.
@@ -723,6 +842,9 @@ namespace Faunus
 		 * The move directions can be controlled with the dir vector - for instance if you wish
 		 * to translate only in the `z` direction, set `dir.x()=dir.y()=0`.
 		 *
+		 * If `batch_size` is larger than one, proposals in atomic groups are generated in
+		 * batches and the energy changes of a batch are evaluated in parallel, see `move()`.
+		 *
 		 * @date Lund, 2011
 		 */
 		template<class Tspace>
@@ -740,6 +862,7 @@ namespace Faunus
 				void _rejectMove() override;
 				double _energyChange() override;
 				void _trialMove() override;
+				std::vector<typename base::Tunable> _tunables() override;
 				using base::spc;
 				map_type accmap; //!< Single particle acceptance map
 				map_type sqrmap; //!< Single particle mean square displacement map
@@ -749,10 +872,36 @@ namespace Faunus
 				double genericdp;//!< Generic atom displacement parameter - ignores individual dps
 				Average<unsigned long long int> gsize; //!< Average size of igroup;
 
+				int batchsize;          //!< Number of proposals per batch (1 = no batching)
+				double batchcutoff;     //!< Proposals closer than this interact (0 = serial)
+				Average<double> batchind; //!< Fraction of independent proposals in batches
+
+				struct Proposal
+				{
+					int i;                     //!< Moved particle
+					Group *g;                  //!< Group of particle
+					typename Tspace::ParticleType pos; //!< Trial position
+					typename Tspace::Change c; //!< Change of this proposal, only
+					double du;                 //!< Energy change
+					bool ok;                   //!< Independent of other proposals
+				};
+
+				Point disp;              //!< Displacement made by last `displace()`
+
+				void displace();         //!< Displace `iparticle` in trial vector
+				bool parallel();         //!< True if proposals can be evaluated in parallel
+				double moveBatch( int ); //!< Propose and evaluate a batch of moves
+				double evaluateBatch( std::vector<Proposal> &, typename Tspace::Change & ); //!< Accept/reject proposals
+				double evaluateSingle( Proposal & ); //!< Accept/reject a single proposal
+
 			public:
 
 				AtomicTranslation( Energy::Energybase<Tspace> &, Tspace &, Tmjson & );
 
+				double move( int= 1 ) override;
+
+				double sweep(); //!< Checkerboard sweep over all particles
+
 				void setGenericDisplacement( double ); //!< Set single displacement for all atoms
 
 				Point dir;             //!< Translation directions (default: x=y=z=1)
@@ -771,6 +920,16 @@ namespace Faunus
 		 * `permol`             | Repeat move for each molecule in system (default: false)
 		 * `prob`               | Probability of performing the move (default: 1)
 		 *
+		 * In addition, the following keywords apply to all molecules,
+		 *
+		 * Value                | Description
+		 * :------------------- | :-------------------------------------------------------------
+		 * `batch_size`         | Number of proposals evaluated in parallel (default: 1 = off)
+		 * `batch_cutoff`       | Distance beyond which particles do not interact (required for batches)
+		 *
+		 * `batch_cutoff` must be at least the range of the Hamiltonian, see
+		 * `Energy::Energybase::cutoff()`.
+		 *
 		 * Example:
 		 *
 		 *     {
@@ -788,6 +947,12 @@ namespace Faunus
 				igroup = nullptr;
 				dir = {1, 1, 1};
 				genericdp = 0;
+				batchsize = j.value("batch_size", 1);
+				batchcutoff = j.value("batch_cutoff", 0.0);
+				if ( batchsize > 1 && batchcutoff <= 0 )
+					throw std::runtime_error(base::title + ": batch_size requires a positive batch_cutoff");
+				if ( batchsize > 1 && batchcutoff < e.cutoff())
+					throw std::runtime_error(base::title + ": batch_cutoff is shorter than the range of the energy");
 				base::fillMolList(j);
 			}
 
@@ -830,6 +995,12 @@ namespace Faunus
 					iparticle = igroup->random();
 					gsize += igroup->size();
 				}
+				displace();
+			}
+
+		template<class Tspace>
+			void AtomicTranslation<Tspace>::displace()
+			{
 				if ( iparticle > -1 )
 				{
 					double dp = atom[spc->p.at(iparticle).id].dp;
@@ -837,11 +1008,11 @@ namespace Faunus
 						dp = genericdp;
 					assert(iparticle < (int) spc->p.size()
 							&& "Trial particle out of range");
-					Point t = dir * dp;
-					t.x() *= slump() - 0.5;
-					t.y() *= slump() - 0.5;
-					t.z() *= slump() - 0.5;
-					spc->trial[iparticle].translate(spc->geo, t);
+					disp = dir * dp;
+					disp.x() *= slump() - 0.5;
+					disp.y() *= slump() - 0.5;
+					disp.z() *= slump() - 0.5;
+					spc->trial[iparticle].translate(spc->geo, disp);
 
 					// make sure trial mass center is updated for molecular groups
 					// (certain energy functions may rely on up-to-date mass centra)
@@ -852,15 +1023,29 @@ namespace Faunus
 						gi->cm_trial = Geometry::massCenter(spc->geo, spc->trial, *gi);
 
 #ifndef NDEBUG
-					// are untouched particles in group synched?
-					for ( auto j : *gi )
-						if ( j != iparticle )
-							assert((base::spc->p[j] - base::spc->trial[j]).squaredNorm() < 1e-6);
+					// are untouched particles in group synched? (not so within batches)
+					if ( batchsize < 2 )
+						for ( auto j : *gi )
+							if ( j != iparticle )
+								assert((base::spc->p[j] - base::spc->trial[j]).squaredNorm() < 1e-6);
 #endif
 				}
 				base::change.mvGroup[spc->findIndex(igroup)].push_back(iparticle);
 			}
 
+		/** Atomic displacement parameters, `AtomData::dp`, of moved atoms */
+		template<class Tspace>
+			std::vector<typename Movebase<Tspace>::Tunable> AtomicTranslation<Tspace>::_tunables()
+			{
+				std::vector<typename base::Tunable> v;
+				for ( auto &m : sqrmap )
+				{
+					auto id = m.first;
+					v.push_back({atom[id].name + " dp", &atom[id].dp, [this, id]() { return sqrmap[id].sum; }});
+				}
+				return v;
+			}
+
 		template<class Tspace>
 			void AtomicTranslation<Tspace>::_acceptMove()
 			{
@@ -898,6 +1083,342 @@ namespace Faunus
 				return 0;
 			}
 
+		template<class Tspace>
+			bool AtomicTranslation<Tspace>::parallel()
+			{
+				bool atomic = (igroup != nullptr) ? igroup->isAtomic() : !this->mollist.empty();
+				for ( auto &m : this->mollist )
+					if ( !spc->molList()[m.first].isAtomic())
+						atomic = false;
+				return atomic && batchcutoff > 0 && base::pot->concurrent();
+			}
+
+		/**
+		 * Without batches (`batch_size` of one) this is `Movebase::move()`.
+		 *
+		 * With batches, up to `batch_size` proposals are collected as long as
+		 * each is independent, i.e. its old and new positions are at least
+		 * `batch_cutoff` away from the old and new positions of all earlier
+		 * proposals in the batch. The energy change of an independent proposal
+		 * is therefore the same whether or not earlier proposals are accepted,
+		 * and the batch is evaluated in parallel and accepted or rejected in
+		 * order. A dependent proposal ends the batch: it is undone, the batch is
+		 * evaluated, and the same displacement is then applied to the updated
+		 * configuration and evaluated on its own before a new batch is started.
+		 * Each proposal thus sees all earlier decisions, which is the same as
+		 * running them one at a time.
+		 *
+		 * This requires that `batch_cutoff` is at least `Energybase::cutoff()`,
+		 * which is checked on construction. Batches are used only if
+		 * `Energybase::concurrent()` is true and all moved groups are atomic.
+		 * If `external()` changes in a batch, e.g. with Ewald summation, batches
+		 * are switched off.
+		 */
+		template<class Tspace>
+			double AtomicTranslation<Tspace>::move( int n )
+			{
+				if ( batchsize < 2 || !parallel())
+					return base::move(n);
+
+				base::timer.start();
+				double utot = 0;
+				if ( !this->mollist.empty())
+				{
+					this->currentMolId = this->randomMolId();
+					n = this->mollist[this->currentMolId].repeat;
+					base::runfraction = this->mollist[this->currentMolId].prob;
+				}
+				if ( run())
+					while ( n > 0 )
+					{
+						int m = std::min(n, batchsize);
+						utot += moveBatch(m);
+						n -= m;
+					}
+				assert(spc->p == spc->trial && "Trial particle vector out of sync!");
+				base::timer.stop();
+				base::tune();
+				return utot;
+			}
+
+		template<class Tspace>
+			double AtomicTranslation<Tspace>::moveBatch( int m )
+			{
+				std::vector<Proposal> b;
+				typename Tspace::Change all;   // all proposals in batch
+				double utot = 0, rc2 = batchcutoff * batchcutoff;
+
+				for ( int k = 0; k < m; k++ )
+				{
+					base::trialMove();
+					Proposal t = {iparticle, igroup, spc->trial[iparticle], base::change, 0, batchsize > 1};
+					base::change.clear();
+					for ( auto &l : b )
+						for ( auto a : {&spc->p[l.i], &l.pos} )
+							for ( auto c : {&spc->p[t.i], &t.pos} )
+								if ( spc->geo.sqdist(*a, *c) < rc2 )
+									t.ok = false;
+					batchind += t.ok;
+					if ( t.ok )
+					{
+						all.mvGroup[spc->findIndex(t.g)].push_back(t.i);
+						b.push_back(t);
+						continue;
+					}
+					// undo, evaluate the batch and re-apply displacement to the outcome
+					spc->trial[t.i] = spc->p[t.i];
+					for ( auto &l : b )
+						if ( l.i == t.i )
+							spc->trial[t.i] = l.pos;
+					utot += evaluateBatch(b, all);
+					b.clear();
+					all.clear();
+					spc->trial[t.i].translate(spc->geo, disp);
+					t.pos = spc->trial[t.i];
+					utot += evaluateSingle(t);
+				}
+				return utot + evaluateBatch(b, all);
+			}
+
+		/**
+		 * The trial position of `t` must be set on entry and all other
+		 * particles must be in sync.
+		 */
+		template<class Tspace>
+			double AtomicTranslation<Tspace>::evaluateSingle( Proposal &t )
+			{
+				double utot = 0;
+				iparticle = t.i;
+				igroup = t.g;
+				base::change = t.c;
+				spc->syncArrays(base::change);
+				base::pot->updateChange(base::change);
+				double du = base::energyChange();
+				bool acc = base::metropolis(du);
+				if ( acc )
+				{
+					base::acceptMove();
+					base::dusum += du;
+					utot += du;
+				}
+				else
+					base::rejectMove();
+				spc->syncArrays(base::change);
+				utot += base::pot->update(acc);
+				base::change.clear();
+				return utot;
+			}
+
+		/**
+		 * Energy changes of the independent proposals (`ok`) in `b` are evaluated in
+		 * parallel and each is accepted or rejected in order. `all` lists all
+		 * independent proposals, whose trial positions must be set on entry.
+		 * Dependent proposals must have been rejected beforehand.
+		 *
+		 * The first proposal is evaluated serially so that state built on demand
+		 * by the energy, e.g. `Space::arrays()` mirrors and cell lists, is in place
+		 * before the parallel region. Energies that are still not
+		 * `Energybase::concurrent()` are evaluated serially.
+		 */
+		template<class Tspace>
+			double AtomicTranslation<Tspace>::evaluateBatch(
+					std::vector<Proposal> &b, typename Tspace::Change &all )
+			{
+				double utot = 0;
+				if ( all.empty())
+					return utot;
+
+				spc->syncArrays(all);
+				base::pot->updateChange(all);
+				if ( std::fabs(base::pot->external(spc->trial) - base::pot->external(spc->p)) > 1e-10 )
+				{ // energy is not additive over proposals: switch off batches and run one by one
+					std::cerr << base::title << ": external energy changes in batch; batches disabled" << endl;
+					batchsize = 1;
+					batchcutoff = 0;
+					utot += base::pot->update(false);
+					for ( auto &t : b )
+						if ( t.ok )
+							spc->trial[t.i] = spc->p[t.i];
+					spc->syncArrays(all);
+					for ( auto &t : b )
+						if ( t.ok )
+						{
+							spc->trial[t.i] = t.pos;
+							utot += evaluateSingle(t);
+						}
+					return utot;
+				}
+
+				int nb = b.size(), first = 0;
+				while ( first < nb && !b[first].ok )
+					first++;
+				b[first].du = Energy::energyChange(*spc, *base::pot, b[first].c);
+				bool concurrent = base::pot->concurrent();
+#pragma omp parallel for schedule (dynamic) if (concurrent)
+				for ( int k = first + 1; k < nb; k++ )
+					if ( b[k].ok )
+						b[k].du = Energy::energyChange(*spc, *base::pot, b[k].c);
+				utot += base::pot->update(false);
+
+				// accept or reject in order; rejected particles are restored
+				// and the net change of the batch is passed to the energy
+				std::vector<bool> acc(nb, false);
+				typename Tspace::Change net;
+				for ( int k = 0; k < nb; k++ )
+					if ( b[k].ok )
+					{
+						iparticle = b[k].i;
+						igroup = b[k].g;
+						acc[k] = base::metropolis(b[k].du);
+						if ( acc[k] )
+							net.mvGroup[spc->findIndex(b[k].g)].push_back(b[k].i);
+						else
+							base::rejectMove();
+					}
+				spc->syncArrays(all);
+				if ( !net.empty())
+				{
+					base::pot->updateChange(net);
+					for ( int k = 0; k < nb; k++ )
+						if ( acc[k] )
+						{
+							iparticle = b[k].i;
+							igroup = b[k].g;
+							base::acceptMove();
+							base::dusum += b[k].du;
+							utot += b[k].du;
+						}
+					spc->syncArrays(net);
+					utot += base::pot->update(true);
+				}
+				return utot;
+			}
+
+		/**
+		 * Checkerboard sweep for short ranged systems. The box inscribing the
+		 * container is divided into cells at least `batch_cutoff` wide with a
+		 * random offset of the grid in each sweep. In periodic directions the
+		 * grid wraps around and the number of cells is even (or one); in open
+		 * directions, e.g. for `Geometry::Sphere` or the `z` direction of
+		 * `Geometry::Cuboidslit`, the grid does not wrap and an extra cell covers
+		 * the offset. The cells are coloured by the parity of their indices giving
+		 * eight colours, visited in random order.
+		 * For each colour, every cell of that colour proposes one translation of
+		 * a random particle inside it and this is repeated until about one move
+		 * per particle has been attempted. Trial positions outside the cell are
+		 * rejected so that cells of the same colour never interact and their
+		 * proposals are evaluated in parallel as in `move()`.
+		 *
+		 * The swept molecule and the probability of running are chosen as in
+		 * `move()`. If the proposals cannot be evaluated in parallel (see `move()`)
+		 * this falls back to `move()`. Acceptance and displacement statistics are
+		 * merged into the usual per atom averages.
+		 */
+		template<class Tspace>
+			double AtomicTranslation<Tspace>::sweep()
+			{
+				if ( batchsize < 2 || !parallel())
+					return move();
+
+				base::timer.start();
+				double utot = 0;
+				if ( !this->mollist.empty())
+				{
+					this->currentMolId = this->randomMolId();
+					base::runfraction = this->mollist[this->currentMolId].prob;
+					dir = this->mollist[this->currentMolId].dir;
+				}
+				if ( !run())
+				{
+					base::timer.stop();
+					base::tune();
+					return utot;
+				}
+				if ( base::cnt == 0 )
+					for ( auto g : spc->groupList())
+						g->setMassCenter(*spc);
+
+				std::vector<std::pair<int, Group *>> cand; // particles to move
+				if ( !this->mollist.empty())
+				{
+					for ( auto g : spc->findMolecules(this->currentMolId))
+						for ( auto i : *g )
+							cand.push_back({i, g});
+				}
+				else
+					for ( auto i : *igroup )
+						cand.push_back({i, igroup});
+
+				typedef Geometry::CellListSelector<typename Tspace::GeometryType> Tselector;
+				bool periodic[3] = {Tselector::dense, Tselector::dense, Tselector::pbcz};
+				Point len = spc->geo.inscribe().len, w, shift;
+				int n[3];
+				for ( int d = 0; d < 3; d++ )
+				{
+					n[d] = std::max(1, int(len[d] / batchcutoff));
+					if ( periodic[d] && n[d] > 1 && n[d] % 2 == 1 )
+						n[d]--;
+					w[d] = len[d] / n[d];
+					shift[d] = w[d] * slump();
+					if ( !periodic[d] )
+						n[d]++; // offset grid covers one more cell
+				}
+				auto cellIndex = [&]( const Point &a ) {
+					int c = 0;
+					for ( int d = 0; d < 3; d++ )
+					{
+						double x = a[d] + 0.5 * len[d] + shift[d];
+						if ( periodic[d] )
+							x -= len[d] * std::floor(x / len[d]);
+						c = c * n[d] + std::max(0, std::min(int(x / w[d]), n[d] - 1));
+					}
+					return c;
+				};
+				auto colour = [&]( int c ) {
+					int k = c % n[2], j = (c / n[2]) % n[1], i = c / (n[1] * n[2]);
+					return (i % 2) * 4 + (j % 2) * 2 + (k % 2);
+				};
+
+				std::vector<std::vector<int>> cells(n[0] * n[1] * n[2]);
+				for ( size_t k = 0; k < cand.size(); k++ )
+					cells[cellIndex(spc->p[cand[k].first])].push_back(k);
+
+				std::vector<int> colours = {0, 1, 2, 3, 4, 5, 6, 7};
+				std::shuffle(colours.begin(), colours.end(), slump.eng);
+				int phases = (cand.size() + cells.size() - 1) / cells.size();
+
+				for ( int col : colours )
+					for ( int phase = 0; phase < phases && batchsize > 1; phase++ ) // unless switched off
+					{
+						std::vector<Proposal> b;
+						typename Tspace::Change all;
+						for ( size_t c = 0; c < cells.size(); c++ )
+							if ( !cells[c].empty() && colour(c) == col )
+							{
+								auto &pick = cand[*slump.element(cells[c].begin(), cells[c].end())];
+								iparticle = pick.first;
+								igroup = pick.second;
+								base::cnt++;
+								gsize += igroup->size();
+								displace();
+								Proposal t = {iparticle, igroup, spc->trial[iparticle], base::change, 0,
+									cellIndex(spc->trial[iparticle]) == int(c)};
+								base::change.clear();
+								if ( t.ok )
+									all.mvGroup[spc->findIndex(t.g)].push_back(t.i);
+								else
+									base::rejectMove();
+								batchind += t.ok;
+								b.push_back(t);
+							}
+						utot += evaluateBatch(b, all);
+					}
+				assert(spc->p == spc->trial && "Trial particle vector out of sync!");
+				base::timer.stop();
+				base::tune();
+				return utot;
+			}
+
 		template<class Tspace>
 			string AtomicTranslation<Tspace>::_info()
 			{
@@ -911,6 +1432,10 @@ namespace Faunus
 				if ( genericdp > 1e-6 )
 					o << pad(SUB, base::w, "Generic displacement")
 						<< genericdp << _angstrom << endl;
+				if ( batchind.cnt > 0 )
+					o << pad(SUB, base::w, "Batch size") << batchsize << endl
+						<< pad(SUB, base::w, "Batch cutoff") << batchcutoff << _angstrom << endl
+						<< pad(SUB, base::w, "Independent proposals") << batchind.avg() * 100 << percent << endl;
 				if ( base::cnt > 0 )
 				{
 					char l = 12;
@@ -989,6 +1514,7 @@ namespace Faunus
 				void _trialMove();
 				void _acceptMove();
 				void _rejectMove();
+				std::vector<typename base::Tunable> _tunables() override;
 				double dprot;      //!< Temporary storage for current angle
 
 			public:
@@ -1034,6 +1560,19 @@ namespace Faunus
 				base::change.mvGroup[spc->findIndex(igroup)].push_back(iparticle);
 			}
 
+		/** Atomic rotational displacement parameters, `AtomData::dprot`, of moved atoms */
+		template<class Tspace>
+			std::vector<typename AtomicTranslation<Tspace>::Tunable> AtomicRotation<Tspace>::_tunables()
+			{
+				std::vector<typename base::Tunable> v;
+				for ( auto &m : sqrmap )
+				{
+					auto id = m.first;
+					v.push_back({atom[id].name + " dprot", &atom[id].dprot, [this, id]() { return sqrmap[id].sum; }});
+				}
+				return v;
+			}
+
 		template<class Tspace>
 			void AtomicRotation<Tspace>::_acceptMove()
 			{
@@ -1225,6 +1764,7 @@ namespace Faunus
 				Tmjson _json() override;
 				double _energyChange() override;
 				string _info() override;
+				std::vector<typename base::Tunable> _tunables() override;
 				typedef std::map<string, Average<double> > map_type;
 				map_type accmap;   //!< Group particle acceptance map
 				map_type sqrmap_t; //!< Group mean square displacement map (translation)
@@ -1296,6 +1836,20 @@ namespace Faunus
 			}
 		}
 
+		/** Translational and rotational displacement parameters of each molecule */
+		template<class Tspace>
+			std::vector<typename Movebase<Tspace>::Tunable> TranslateRotate<Tspace>::_tunables()
+			{
+				std::vector<typename base::Tunable> v;
+				for ( auto &i : this->mollist )
+				{
+					string name = spc->molList()[i.first].name;
+					v.push_back({name + " dp", &i.second.dp1, [this, name]() { return sqrmap_t[name].sum; }});
+					v.push_back({name + " dprot", &i.second.dp2, [this, name]() { return sqrmap_r[name].sum; }});
+				}
+				return v;
+			}
+
 		template<class Tspace>
 			void TranslateRotate<Tspace>::setGroup( Group &g )
 			{
@@ -1795,6 +2349,13 @@ namespace Faunus
 		 * `clusterradius` | Surface threshold from mobile ion to particle in group (angstrom)
 		 * `clustergroup`  | Group containing atomic particles to be moved with the main molecule
 		 *
+		 * Mobile particles are looked up in a cell list of the cluster group
+		 * that re-bins particles listed in `Space::changeLog()` before each
+		 * trial, so that only particles within `clusterCutoff()` of the main
+		 * group are tested. Derived classes with a probability function of
+		 * unlimited range should let `clusterCutoff()` return zero whereby all
+		 * mobile particles are tested.
+		 *
 		 * @todo Energy evaluation puts all moved particles in an index vector used
 		 * to sum the interaction energy with static particles. This could be optimized
 		 * by only adding mobile ions and calculate i.e. group-group interactions in a
@@ -1823,7 +2384,13 @@ namespace Faunus
 				Average<double> avgsize; //!< Average number of ions in cluster
 				Average<double> avgbias; //!< Average bias
 				Group *gmobile;          //!< Pointer to group with potential cluster particles
+				Geometry::SyncedCellList<typename Tspace::GeometryType> mobcells; //!< Cell list of `gmobile`
+				Geometry::SyncedMaxRadius mobradius; //!< Largest radius in `gmobile`
+				double rcluster;         //!< Current cluster cutoff; zero if unlimited
+				vector<int> candidates;  //!< Mobile particles with possibly non-zero cluster probability
+				void findCandidates( bool ); //!< Mobile particles close to the main group
 				virtual double ClusterProbability( Tpvec &, int ); //!< Probability that particle index belongs to cluster
+				virtual double clusterCutoff(); //!< Distance beyond which `ClusterProbability()` is zero
 			public:
 				using base::spc;
 				TranslateRotateCluster( Energy::Energybase<Tspace> &, Tspace &, Tmjson &j );
@@ -1839,6 +2406,7 @@ namespace Faunus
 				base::title = "Cluster " + base::title;
 				base::cite = "doi:10/cj9gnn";
 				gmobile = nullptr;
+				rcluster = 0;
 
 				auto m = j;
 				base::fillMolList(m);// find molecules to be moved
@@ -1909,8 +2477,12 @@ namespace Faunus
 				assert(igroup != nullptr && "Group to move not defined");
 
 				// find clustered particles
+				rcluster = clusterCutoff();
+				if ( rcluster > 0 )
+					mobcells.sync(spc->geo.inscribe().len, rcluster, spc->p, *gmobile, spc->changeLog(), spc->changeEpoch());
+				findCandidates(false);
 				cindex.clear();
-				for ( auto i : *gmobile )
+				for ( auto i : candidates )
 					if ( ClusterProbability(spc->p, i) > slump())
 						cindex.push_back(i); // generate cluster list
 
@@ -1961,7 +2533,8 @@ namespace Faunus
 			{
 				double bias = 1;             // cluster bias -- see Frenkel 2nd ed, p.405
 				vector<int> imoved = cindex; // index of moved particles
-				for ( auto l : *gmobile )    // mobile index, "l", NOT in cluster (Frenkel's "k" is the main group)
+				findCandidates(true);        // others have zero probability before and after the move
+				for ( auto l : candidates )  // mobile index, "l", NOT in cluster (Frenkel's "k" is the main group)
 					if ( std::find(cindex.begin(), cindex.end(), l) == cindex.end())
 						bias *= (1 - ClusterProbability(spc->trial, l)) / (1 - ClusterProbability(spc->p, l));
 				avgbias += bias;
@@ -2022,6 +2595,46 @@ namespace Faunus
 				return 0;
 			}
 
+		/**
+		 * Range of the default `ClusterProbability()`, i.e. the threshold plus
+		 * twice the largest radius in the main and cluster groups. The latter is
+		 * kept up to date from `Space::changeLog()`. A non-positive value
+		 * disables the cell list.
+		 */
+		template<class Tspace>
+			double TranslateRotateCluster<Tspace>::clusterCutoff()
+			{
+				double rmax = mobradius(spc->p, *gmobile, spc->changeLog(), spc->changeEpoch());
+				for ( auto i : *igroup )
+					rmax = std::max(rmax, spc->p[i].radius);
+				return threshold + 2 * rmax;
+			}
+
+		/**
+		 * Fills `candidates` with the sorted index of mobile particles within
+		 * `rcluster` of the main group in `Space::p` and, if `trial` is true,
+		 * also in `Space::trial`. Without a cutoff all of `gmobile` is used.
+		 */
+		template<class Tspace>
+			void TranslateRotateCluster<Tspace>::findCandidates( bool trial )
+			{
+				candidates.clear();
+				if ( rcluster <= 0 )
+				{
+					candidates.insert(candidates.end(), gmobile->begin(), gmobile->end());
+					return;
+				}
+				auto add = [&]( int j ) { candidates.push_back(j); };
+				for ( auto i : *igroup )
+				{
+					mobcells.forEachNeighbour(spc->p[i], add);
+					if ( trial )
+						mobcells.forEachNeighbour(spc->trial[i], add);
+				}
+				std::sort(candidates.begin(), candidates.end());
+				candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+			}
+
 
 
 
@@ -2076,7 +2689,12 @@ namespace Faunus
 				Average<double> avgsize; //!< Average number of ions in cluster
 				Average<double> avgbias; //!< Average bias
 				vector<vector<Tid>> gstatic;          //!< Pointer to group with potential cluster particles
+				Geometry::SyncedCellList<typename Tspace::GeometryType> cells; //!< Cell list of all particles
+				Geometry::SyncedMaxRadius radius;     //!< Largest radius of all particles
+				double rcluster;                      //!< Current cluster cutoff; zero if unlimited
+				vector<Group *> clusterCandidates( Group * ); //!< Molecules that may cluster with a group
 				virtual double ClusterProbability(Group &, Tpvec &, int ); //!< Probability that particle index belongs to cluster
+				virtual double clusterCutoff(); //!< Distance beyond which `ClusterProbability()` is zero
 			public:
 				using base::spc;
 				ClusterMove( Energy::Energybase<Tspace> &, Tspace &, Tmjson &j );
@@ -2096,6 +2714,7 @@ namespace Faunus
 				dp_trans.resize(spc->molecule.size());
 				dir.resize(spc->molecule.size());
 				spread_cluster.resize(spc->molecule.size());
+				rcluster = 0;
 				base::useAlternativeReturnEnergy=true; // yes, we Metropolis don't need internal energy change
 				for(unsigned int i = 0; i < gstatic.size(); i++)
 					gstatic.at(i).resize(0);
@@ -2172,44 +2791,64 @@ namespace Faunus
 				return o.str();
 			}
 
+		/**
+		 * Molecules are ordered by molecule type and then by their position in
+		 * `Space::groupList()`. Unless `clusterCutoff()` is unlimited, only
+		 * molecules with atoms within `rcluster` of `g` are returned, found
+		 * using a cell list that re-bins particles listed in `Space::changeLog()`
+		 * at the start of each trial move.
+		 */
+		template<class Tspace>
+			vector<Group *> ClusterMove<Tspace>::clusterCandidates(Group *g)
+			{
+				vector<Group *> v;
+				if ( rcluster <= 0 )
+				{
+					for ( size_t i = 0; i < spc->molList().size(); i++ )
+						for ( auto g0 : spc->findMolecules(i) )
+							v.push_back(g0);
+					return v;
+				}
+				for ( auto i : *g )
+					cells.forEachNeighbour(spc->p[i], [&]( int j ) {
+						auto g0 = spc->findGroup(j);
+						if ( g0 != nullptr )
+							v.push_back(g0);
+					});
+				std::sort(v.begin(), v.end(), [&]( Group *a, Group *b ) {
+					return std::make_pair(a->molId, spc->findIndex(a)) < std::make_pair(b->molId, spc->findIndex(b));
+				});
+				v.erase(std::unique(v.begin(), v.end()), v.end());
+				return v;
+			}
+
 		template<class Tspace>
 			void ClusterMove<Tspace>::getClusterAroundMolecule(Group *g)
 			{
-				int cntI = 0;
-				for ( auto &i : spc->molList() ) { 	// For every type of molecule ...
-					bool is_static = false; 	// Start to assume the molecule is not prohibited from being in cluster around molecule 'g'
-					for( auto k : gstatic.at(int(g->molId)) ) { // For every group which is prohibited from being in cluster around molecule 'g' ...
-						if(int(k) == cntI) { 	// Check if molecule 'i' is indeed prohibited from being in the cluster around molecule 'g'
-							is_static = true; // If so then change assumed status
-							break;		// No need to go through more elements in the list of prohibited molecules
-						}
-					}
-					if(is_static)
+				auto &prohibited = gstatic.at(int(g->molId)); // Molecule types prohibited from being in cluster around molecule 'g'
+				for( auto g0 : clusterCandidates(g) ) { 	// For every molecule that may be in the cluster ...
+					if ( std::find(prohibited.begin(), prohibited.end(), g0->molId) != prohibited.end() )
 						continue;
-					// molecule type 'i' is not prohibited from being in the cluster around molecule 'g'
-
-					auto gvec = spc->findMolecules(cntI); 	// Find all molecules of type 'i'
-					for( auto g0 : gvec) { 			// For every molecule of type 'i' ...
-						for(auto index : *g0) { 	// For every atom in molecule ...
-							if ( ClusterProbability(*g,spc->p, index) > slump()) {
-								// Include atom 'index' and thus also molecule 'g0'
-								bool in_cluster = false;			
-								for( unsigned int m = 0; m < cindex.size(); m++ ) {
-									if( *cindex.at(m) == *g0 ) {
-										in_cluster = true;
-										break;	
-									}	
-								} 
-								if(in_cluster)
-									break;
-								cindex.push_back(g0); 			// If not then add molecule to cluster-list
-								if(spread_cluster.at(int(g->molId)))
-									getClusterAroundMolecule(g0);	 	// Get cluster around added molecule
-								break; // No need to go through any more atoms in the molecule
-							}
+					// molecule 'g0' is not prohibited from being in the cluster around molecule 'g'
+
+					for(auto index : *g0) { 	// For every atom in molecule ...
+						if ( ClusterProbability(*g,spc->p, index) > slump()) {
+							// Include atom 'index' and thus also molecule 'g0'
+							bool in_cluster = false;			
+							for( unsigned int m = 0; m < cindex.size(); m++ ) {
+								if( *cindex.at(m) == *g0 ) {
+									in_cluster = true;
+									break;	
+								}	
+							} 
+							if(in_cluster)
+								break;
+							cindex.push_back(g0); 			// If not then add molecule to cluster-list
+							if(spread_cluster.at(int(g->molId)))
+								getClusterAroundMolecule(g0);	 	// Get cluster around added molecule
+							break; // No need to go through any more atoms in the molecule
 						}
 					}
-					cntI++;
 				}
 			}
 
@@ -2229,6 +2868,10 @@ namespace Faunus
 
 				assert(igroup != nullptr && "Group to move not defined");
 				// find clustered particlesi
+				rcluster = clusterCutoff();
+				if ( rcluster > 0 )
+					cells.sync(spc->geo.inscribe().len, rcluster, spc->p, Group(0, int(spc->p.size()) - 1),
+							spc->changeLog(), spc->changeEpoch());
 				cindex.clear();
 				cindex.push_back(igroup);
 				getClusterAroundMolecule(igroup);
@@ -2417,8 +3060,6 @@ namespace Faunus
 				// note: this could be optimized!
 				double u_c2nc_new = 0;   //cluster to non-cluster molecules
 				double u_c2nc_old = 0;
-#pragma omp parallel for reduction (+:du)
-
 				for (auto i : cindex)  {
 					for (auto j : spc->groupList()) {
 						bool in_cluster = false;
@@ -2473,6 +3114,18 @@ namespace Faunus
 				return 0.0;
 			}
 
+		/**
+		 * Range of the default `ClusterProbability()`, i.e. the largest threshold
+		 * plus twice the largest particle radius, kept up to date from
+		 * `Space::changeLog()`. A non-positive value disables the cell list.
+		 */
+		template<class Tspace>
+			double ClusterMove<Tspace>::clusterCutoff()
+			{
+				double rmax = radius(spc->p, Group(0, int(spc->p.size()) - 1), spc->changeLog(), spc->changeEpoch());
+				return *std::max_element(threshold.begin(), threshold.end()) + 2 * rmax;
+			}
+
 
 
 
@@ -3001,8 +3654,6 @@ namespace Faunus
 				// note: this could be optimized!
 				double u_c2nc_new = 0;   //cluster to non-cluster molecules
 				double u_c2nc_old = 0;
-#pragma omp parallel for reduction (+:du)
-
 				for (auto i : cindex)  {
 					for (auto j : spc->groupList()) {
 						bool in_cluster = false;
@@ -3108,6 +3759,8 @@ namespace Faunus
 
 				double ClusterProbability( typename base::Tpvec &p, int i ) override { return 1; }
 
+				double clusterCutoff() override { return 0; }
+
 			public:
 				TranslateRotateGroupCluster( Tmjson &j, Energy::Energybase<Tspace> &e,
 						Tspace &s ) : base(j, e, s)
@@ -3293,7 +3946,9 @@ namespace Faunus
 				void _rejectMove() override;
 				double _energyChange() override;
 				string _info() override;
+				std::vector<typename base::Tunable> _tunables() override;
 				virtual bool findParticles(); //!< This will set the end points and find particles to rotate
+				bool isRigid();               //!< True if pairs within the rotated segment keep their energy
 			protected:
 				std::map<int, int> _minlen, _maxlen;
 				using base::spc;
@@ -3345,6 +4000,19 @@ namespace Faunus
 		template<class Tspace>
 			CrankShaft<Tspace>::~CrankShaft() {}
 
+		/** Rotational displacement parameter of each molecule */
+		template<class Tspace>
+			std::vector<typename Movebase<Tspace>::Tunable> CrankShaft<Tspace>::_tunables()
+			{
+				std::vector<typename base::Tunable> v;
+				for ( auto &i : this->mollist )
+				{
+					string name = spc->molList()[i.first].name;
+					v.push_back({name + " dp", &i.second.dp1, [this, name]() { return accmap.msqsum(name); }});
+				}
+				return v;
+			}
+
 		template<class Tspace>
 			void CrankShaft<Tspace>::_trialMove()
 			{
@@ -3400,12 +4068,55 @@ namespace Faunus
 			}
 
 		/**
-		 * @todo g_internal is not really needed - index<->g would be faster
+		 * Particle positions are rotated, but not their orientations, so
+		 * particles must be isotropic. Under periodic boundaries the rotation
+		 * is rigid only if the minimum image distances of the segment to the
+		 * rotation origin, and hence between segment particles, are true
+		 * distances before and after the move. This is ensured by requiring all
+		 * rotated particles to be within a quarter of the smallest box length
+		 * from the origin.
+		 */
+		template<class Tspace>
+			bool CrankShaft<Tspace>::isRigid()
+			{
+				if ( !std::is_same<typename Tspace::ParticleType, PointParticle>::value )
+					return false;
+				double r = spc->geo.inscribe().len.minCoeff() / 4;
+				for ( auto i : index )
+					if ( spc->geo.sqdist(spc->p[i], vrot.getOrigin()) > r * r )
+						return false;
+				return index.back() - index.front() + 1 == int(index.size());
+			}
+
+		/**
+		 * The rotated particles form a contiguous segment that moves as a rigid
+		 * body and only its interactions with the rest of the chain, with other
+		 * groups and external potentials are evaluated, see `Energy::segmentEnergy()`.
+		 * The cost hence scales with the segment length rather than the chain length.
+		 * If the energy is not `Energybase::pairwise()` or the segment may not
+		 * move rigidly, see `isRigid()`, the energy of the whole chain is evaluated.
 		 */
 		template<class Tspace>
 			double CrankShaft<Tspace>::_energyChange()
 			{
-				return Energy::energyChange(*spc, *base::pot, base::change);
+				if ( base::change.empty())
+					return 0;
+				if ( !pot->pairwise() || !isRigid())
+					return Energy::energyChange(*spc, *base::pot, base::change);
+				for ( auto i : index )
+					if ( spc->geo.collision(spc->trial[i], spc->trial[i].radius, Geometry::Geometrybase::BOUNDARY))
+						return pc::infty;
+
+				Group seg(index.front(), index.back());
+				double unew = pot->external(spc->trial) + pot->g_external(spc->trial, *gPtr);
+				if ( unew == pc::infty )
+					return pc::infty;       // early rejection
+				unew += Energy::segmentEnergy(*spc, *pot, spc->trial, *gPtr, seg);
+				if ( unew == pc::infty )
+					return pc::infty;
+				double uold = pot->external(spc->p) + pot->g_external(spc->p, *gPtr)
+					+ Energy::segmentEnergy(*spc, *pot, spc->p, *gPtr, seg);
+				return unew - uold;
 			}
 
 		/**
@@ -3547,6 +4258,9 @@ namespace Faunus
 				string _info() override;
 				Group *gPtr;
 				double bondlength; //!< Reptation length used when generating new head group position
+				int head;          //!< End point given a new position in the trial move
+				int tail;          //!< End point whose old position is dropped in the trial move
+				bool isUniform();  //!< True if all monomers and bonds of the chain are identical
 			protected:
 				using base::pot;
 				using base::spc;
@@ -3633,6 +4347,10 @@ namespace Faunus
 					spc->geo.boundary(spc->trial[i]);  // respect boundary conditions
 
 				gPtr->cm_trial = Geometry::massCenter(spc->geo, spc->trial, *gPtr);
+				head = first;
+				tail = (first == gPtr->front()) ? gPtr->back() : gPtr->front();
+
+				base::change.mvGroup[spc->findIndex(gPtr)].clear(); // all particles have moved
 			}
 
 		template<class Tspace>
@@ -3649,6 +4367,41 @@ namespace Faunus
 				gPtr->undo(*spc);
 			}
 
+		/**
+		 * Monomers must be identical point particles. Bonds are compared via
+		 * `Energybase::i2i()` of each shifted neighbour pair with the pair it was
+		 * shifted from, which is exact for the current trial move.
+		 */
+		template<class Tspace>
+			bool Reptation<Tspace>::isUniform()
+			{
+				if ( !std::is_same<typename Tspace::ParticleType, PointParticle>::value )
+					return false; // anisotropic properties do not follow the shifted positions
+				auto &a = spc->p[gPtr->front()];
+				for ( auto i : *gPtr )
+					if ( spc->p[i].id != a.id || spc->p[i].charge != a.charge || spc->p[i].radius != a.radius )
+						return false;
+				int s = (head == gPtr->front()) ? -1 : 1; // trial[k] = p[k+s] for all but head
+				for ( int k = gPtr->front(); k < gPtr->back(); k++ )
+					if ( k != head && k + 1 != head )
+					{
+						double unew = pot->i2i(spc->trial, k, k + 1), uold = pot->i2i(spc->p, k + s, k + 1 + s);
+						if ( std::fabs(unew - uold) > 1e-9 * std::max(1.0, std::fabs(uold)))
+							return false;
+					}
+				return true;
+			}
+
+		/**
+		 * For a chain of identical monomers and bonds, reptation is
+		 * equivalent to moving the particle at the trailing end to the new
+		 * head position. If the energy is `Energybase::pairwise()`, only the
+		 * interactions of these two particles with the rest of the chain and
+		 * with other groups are then evaluated, i.e. \f$ O(L) \f$ work for a
+		 * chain of length \f$ L \f$. Bonds other than between neighbouring
+		 * monomers must be uniform too. Otherwise the internal energy of the
+		 * whole chain and its interaction with all other groups is recalculated.
+		 */
 		template<class Tspace>
 			double Reptation<Tspace>::_energyChange()
 			{
@@ -3656,19 +4409,30 @@ namespace Faunus
 					if ( spc->geo.collision(spc->trial[i], spc->trial[i].radius, Geometry::Geometrybase::BOUNDARY))
 						return pc::infty;
 
-				double unew = pot->g_external(spc->trial, *gPtr) + pot->g_internal(spc->trial, *gPtr);
+				bool ends = pot->pairwise() && isUniform();
+				double unew = pot->external(spc->trial) + pot->g_external(spc->trial, *gPtr)
+					+ (ends ? pot->i2g(spc->trial, *gPtr, head) : pot->g_internal(spc->trial, *gPtr));
 				if ( unew == pc::infty )
 					return pc::infty;       // early rejection
-				double uold = pot->g_external(spc->p, *gPtr) + pot->g_internal(spc->p, *gPtr);
+				double uold = pot->external(spc->p) + pot->g_external(spc->p, *gPtr)
+					+ (ends ? pot->i2g(spc->p, *gPtr, tail) : pot->g_internal(spc->p, *gPtr));
+#ifndef NDEBUG
+				if ( ends )
+				{
+					double du = pot->external(spc->trial) + pot->g_external(spc->trial, *gPtr) + pot->g_internal(spc->trial, *gPtr)
+						- pot->external(spc->p) - pot->g_external(spc->p, *gPtr) - pot->g_internal(spc->p, *gPtr);
+					assert(std::fabs(unew - uold - du) < 1e-6 * std::max(1.0, std::fabs(du)) && "Chain is not uniform");
+				}
+#endif
 
 				for ( auto g : spc->groupList())
 				{
 					if ( g != gPtr )
 					{
-						unew += pot->g2g(spc->trial, *g, *gPtr);
+						unew += ends ? pot->i2g(spc->trial, *g, head) : pot->g2g(spc->trial, *g, *gPtr);
 						if ( unew == pc::infty )
 							return pc::infty;   // early rejection
-						uold += pot->g2g(spc->p, *g, *gPtr);
+						uold += ends ? pot->i2g(spc->p, *g, tail) : pot->g2g(spc->p, *g, *gPtr);
 					}
 				}
 				return unew - uold;
@@ -3702,6 +4466,11 @@ namespace Faunus
 		 * Note that new volumes are generated according to
 		 * \f$ V^{\prime} = \exp\left ( \log V \pm \delta dp \right ) \f$
 		 * where \f$\delta\f$ is a random number between zero and one half.
+		 *
+		 * If the scaling is isotropic and all energy terms provide
+		 * `Energybase::scaledEnergyChange()`, this is used instead of
+		 * recalculating the energy at the old and new volume; see
+		 * `Energy::Nonbonded` for the `powerlaw` option.
 		 */
 		template<class Tspace>
 			class Isobaric : public Movebase<Tspace>
@@ -3716,6 +4485,10 @@ namespace Faunus
 				void _rejectMove() override;
 				template<class Tpvec> double _energy( const Tpvec & );
 				double _energyChange() override;
+				std::vector<typename base::Tunable> _tunables() override
+				{
+					return {{"dp", &dp, [this]() { return msd.sum; }}};
+				}
 				using base::spc;
 				using base::pot;
 				using base::w;
@@ -3726,6 +4499,7 @@ namespace Faunus
 				double newval;
 				Point oldlen;
 				Point newlen;
+				double scale;              //!< Linear scaling of all distances, zero if anisotropic
 				Average<double> msd;       //!< Mean squared volume displacement
 				Average<double> val;          //!< Average volume
 				Average<double> rval;         //!< Average 1/volume
@@ -3741,6 +4515,7 @@ namespace Faunus
 
 				this->title = "Isobaric Volume Fluctuations";
 				this->w = 30;
+				scale = 0;
 				dp = j.at("dp");
 				P = j.at("pressure").get<double>() * 1.0_mM;
 				base::runfraction = j.value("prob", 1.0);
@@ -3821,6 +4596,7 @@ namespace Faunus
 				double xyz = cbrt(newval / oldval);
 				double xy = sqrt(newval / oldval);
 				newlen.scale(spc->geo, s, xyz, xy);
+				scale = spc->geo.isotropicScale(s, xyz, xy);
 				for ( auto g : spc->groupList())
 				{
 					g->setMassCenter(*spc);
@@ -3902,6 +4678,16 @@ namespace Faunus
 		template<class Tspace>
 			double Isobaric<Tspace>::_energyChange()
 			{
+				double du;
+				if ( scale > 0 && pot->scaledEnergyChange(scale, du))
+				{
+					for ( auto g : spc->groupList())
+						for ( auto i : *g )
+							if ( spc->geo_trial.collision(spc->trial[i], spc->trial[i].radius,
+										Geometry::Geometrybase::BOUNDARY))
+								return pc::infty;
+					return du;
+				}
 				return Energy::energyChange(*spc, *pot, change);
 			}
 
@@ -5880,25 +6666,22 @@ namespace Faunus
 				{
 					radiusbak.clear();
 					hydrophobicbak.clear();
-					for ( auto g : spc->groupList())   // loop over all groups
-						if ( g->find(this->ipart))
-						{  //   is ipart part of a group?
-							for ( auto i : *g )    //     if so, loop over that group
-								if ( i != this->ipart )
-								{    //       and ignore ipart
-									assert(abs(spc->p[i].radius - spc->trial[i].radius) < 1e-9);
-									assert(spc->p[i].hydrophobic == spc->trial[i].hydrophobic);
-
-									//radiusbak[i]         = spc->p[i].radius;
-									//spc->p[i].radius     = -spc->p[ipart].radius;
-									//spc->trial[i].radius = -spc->p[ipart].radius;
-
-									hydrophobicbak[i] = spc->p[i].hydrophobic;
-									spc->p[i].hydrophobic = false;
-									spc->trial[i].hydrophobic = false;
-								}
-							return; // a particle can be part of a single group, only
-						}
+					auto g = spc->findGroup(this->ipart); // a particle can be part of a single group, only
+					if ( g != nullptr )
+						for ( auto i : *g )    // loop over that group
+							if ( i != this->ipart )
+							{    // and ignore ipart
+								assert(abs(spc->p[i].radius - spc->trial[i].radius) < 1e-9);
+								assert(spc->p[i].hydrophobic == spc->trial[i].hydrophobic);
+
+								//radiusbak[i]         = spc->p[i].radius;
+								//spc->p[i].radius     = -spc->p[ipart].radius;
+								//spc->trial[i].radius = -spc->p[ipart].radius;
+
+								hydrophobicbak[i] = spc->p[i].hydrophobic;
+								spc->p[i].hydrophobic = false;
+								spc->trial[i].hydrophobic = false;
+							}
 				}
 
 				void restore()
@@ -5962,6 +6745,8 @@ namespace Faunus
 		 * `xtcmove`         | `Move::TrajectoryMove`     | Propagate via a filed trajectory
 		 * `random`          | `RandomTwister<>`          | Input for random number generator
 		 * `_jsonfile`       |  ouput json file name      | Default: `move_out.json`
+		 * `_checkerboard`   |  parallel sweeps           | Default: `false`
+		 * `_tune`           |  displacement tuning       | See below
 		 *
 		 * Average system energy and drift thereof are automatically tracked and
 		 * reported.
@@ -5979,9 +6764,25 @@ namespace Faunus
 		 *
 		 *     "_jsonfile" : "move_out.json"
 		 *
-		 * If the string is empty, no file will be written.
+		 * If the string is empty, no file will be written. Parameters reported by
+		 * the energy, `Energy::Energybase::json()`, e.g. auto-tuned Ewald parameters,
+		 * are written in the section `energy`.
 		 * See @ref inputoutput for more information about pretty printing
 		 * JSON output.
+		 *
+		 * For short ranged systems, `"_checkerboard" : true` replaces each
+		 * `atomtranslate` move by a parallel checkerboard sweep over all its
+		 * particles, see `AtomicTranslation::sweep()`. This requires
+		 * `batch_cutoff` to be set in `atomtranslate` and has no effect
+		 * with polarisation.
+		 *
+		 * Displacement parameters of all moves can be tuned during equilibration
+		 * with, i.e.,
+		 *
+		 *     "_tune" : { "steps":10000, "interval":100 }
+		 *
+		 * where the parameters of each move are adjusted in its first `steps`
+		 * calls and then frozen, see `Movebase::setTuning()`.
 		 */
 		template<typename Tspace, bool polarise = false, typename base=Movebase<Tspace>>
 			class Propagator : public base
@@ -5991,6 +6792,8 @@ namespace Faunus
 				std::vector<basePtr> mPtr;
 				Tspace *spc;
 				string jsonfile; // output json file name
+				bool checkerboard; // replace atomic translation by checkerboard sweeps
+				AtomicTranslation<Tspace> *sweeper; // atomic translation used for sweeps
 
 				double uinit; // initial energy evaluated just *before* first move
 				double dusum; // sum of all energy *changes* by moves
@@ -6049,6 +6852,8 @@ namespace Faunus
 				this->title = "P R O P A G A T O R S";
 
 				jsonfile = "move_out.json";
+				checkerboard = false;
+				sweeper = nullptr;
 
 				auto m = in.at("moves");
 				for ( auto i = m.begin(); i != m.end(); ++i )
@@ -6069,8 +6874,15 @@ namespace Faunus
 								base::_slump() = RandomTwister<>(val);
 							}
 
+						if ( i.key() == "_checkerboard" )
+							checkerboard = val.get<bool>();
+
 						if ( i.key() == "atomtranslate" )
+						{
 							mPtr.push_back(toPtr(AtomicTranslation<Tspace>(e, s, val)));
+							if ( !polarise )
+								sweeper = dynamic_cast<AtomicTranslation<Tspace> *>(mPtr.back().get());
+						}
 						if ( i.key() == "atomrotate" )
 							mPtr.push_back(toPtr(AtomicRotation<Tspace>(e, s, val)));
 						if ( i.key() == "atomgc" )
@@ -6121,6 +6933,11 @@ namespace Faunus
 				if ( mPtr.empty())
 					throw std::runtime_error("No moves defined - check JSON file.");
 
+				auto tn = m.find("_tune");
+				if ( tn != m.end())
+					for ( auto &i : mPtr )
+						i->setTuning(tn->at("steps").get<unsigned long>(), tn->value("interval", 100ul));
+
 				// Bind function to calculate initial system energy
 				using std::ref;
 				ufunction = std::bind(
@@ -6155,7 +6972,11 @@ namespace Faunus
 					if ( uavg.cnt == 0 )
 						uinit = ufunction(); // calculate initial energy, prior to any moves
 
-					du = (*base::_slump().element(mPtr.begin(), mPtr.end()))->move();
+					auto &m = *base::_slump().element(mPtr.begin(), mPtr.end());
+					if ( checkerboard && m.get() == sweeper )
+						du = sweeper->sweep();
+					else
+						du = m->move();
 					dusum += du;
 					uavg += uinit + dusum; // sample average system energy
 					return du;  // return energy change
@@ -6169,6 +6990,9 @@ namespace Faunus
 					for ( auto &i : mPtr )
 						j = merge(j, i->json());
 					j["random"] = base::_slump().json();
+					Tmjson e = base::pot->json();
+					if ( !e.is_null())
+						js["energy"] = e;
 					return js;
 				}
 
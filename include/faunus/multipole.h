@@ -405,6 +405,12 @@ namespace Faunus {
          *  `cutoff`      |  Spherical cutoff in angstroms
          *  `epsr`        |  Relative dielectric constant of the medium
          *
+         *  The splitting function is tabulated with `Tabulate::Andrea` unless `tab_type`
+         *  is set to `uniform`, which selects the constant time lookup of `Tabulate::Uniform`.
+         *  Tolerances are set with `tab_utol` (default 1e-9) and `tab_ftol` (default 1e-2).
+         *  If `tab_cache` is given, the table is stored in and loaded from this file,
+         *  see `Tabulate::TableCache`.
+         *
          *  More info:
          * 
          *  - On the dielectric constant, http://dx.doi.org/10.1080/00268978300102721
@@ -413,23 +419,38 @@ namespace Faunus {
         class CoulombGalore : public PairPotentialBase {
             private:
                 Tabulate::Andrea<double> sf; // splitting function
+                Tabulate::Uniform<double> sfu; // splitting function on uniform grid
                 Tabulate::TabulatorBase<double>::data table; // data for splitting function
+                bool uniform; // use 'sfu' instead of 'sf'
+                typedef Tabulate::TableCache<double> Tcache;
+
+                Tabulate::TabulatorBase<double>::data generate(Tcache &cache, std::function<double(double)> f) {
+                    return uniform ? cache.generate(sfu, f) : cache.generate(sf, f);
+                }
+
+                double splitting(double q) const {
+                    return uniform ? sfu.eval(table, q) : sf.eval(table, q);
+                }
+
+                double splittingDer(double q) const {
+                    return uniform ? sfu.evalDer(table, q) : sf.evalDer(table, q);
+                }
                 std::function<double(double)> calcDielectric; // function for dielectric const. calc.
                 string type;
 		double selfenergy_prefactor;
                 double lB, depsdt, rc, rc2, rc1i, epsr, epsrf, alpha, kappa, I;
                 int order;
 
-                void sfYukawa(const Tmjson &j) {
+                void sfYukawa(const Tmjson &j, Tcache &cache) {
                     kappa = 1.0 / j.at("debyelength").get<double>();
                     I = kappa*kappa / ( 8.0*lB*pc::pi*pc::Nav/1e27 );
-                    table = sf.generate( [&](double q) { return std::exp(-q*rc*kappa) - std::exp(-kappa*rc); } ); // q=r/Rc 
+                    table = generate( cache, [&](double q) { return std::exp(-q*rc*kappa) - std::exp(-kappa*rc); } ); // q=r/Rc 
                     // we could also fill in some info string or JSON output...
                 }
 
-                void sfReactionField(const Tmjson &j) {
+                void sfReactionField(const Tmjson &j, Tcache &cache) {
                     epsrf = j.at("eps_rf");
-                    table = sf.generate( [&](double q) { return 1 + (( epsrf - epsr ) / ( 2 * epsrf + epsr ))*q*q*q - 3 * ( epsrf / ( 2 * epsrf + epsr ))*q ; } ); 
+                    table = generate( cache, [&](double q) { return 1 + (( epsrf - epsr ) / ( 2 * epsrf + epsr ))*q*q*q - 3 * ( epsrf / ( 2 * epsrf + epsr ))*q ; } ); 
                     calcDielectric = [&](double M2V) {
                         if(epsrf > 1e10)
                             return 1 + 3*M2V;
@@ -444,46 +465,46 @@ namespace Faunus {
                     // we could also fill in some info string or JSON output...
                 }
 
-                void sfQpotential(const Tmjson &j)
+                void sfQpotential(const Tmjson &j, Tcache &cache)
                 {
                     order = j.value("order",300);
-                    table = sf.generate( [&](double q) { return qPochhammerSymbol( q, 1, order ); } );
+                    table = generate( cache, [&](double q) { return qPochhammerSymbol( q, 1, order ); } );
                     calcDielectric = [&](double M2V) { return 1 + 3*M2V; };
 		    selfenergy_prefactor = 0.5;
                 }
 
-                void sfYonezawa(const Tmjson &j)
+                void sfYonezawa(const Tmjson &j, Tcache &cache)
                 {
                     alpha = j.at("alpha");
-                    table = sf.generate( [&](double q) { return 1 - erfc(alpha*rc)*q + q*q; } );
+                    table = generate( cache, [&](double q) { return 1 - erfc(alpha*rc)*q + q*q; } );
 		    calcDielectric = [&](double M2V) { return 1 + 3*M2V; };
 		    selfenergy_prefactor = erf(alpha*rc);
                 }
 
-                void sfFanourgakis(const Tmjson &j) {
-                    table = sf.generate( [&](double q) { return 1 - 1.75*q + 5.25*pow(q,5) - 7*pow(q,6) + 2.5*pow(q,7); } );
+                void sfFanourgakis(const Tmjson &j, Tcache &cache) {
+                    table = generate( cache, [&](double q) { return 1 - 1.75*q + 5.25*pow(q,5) - 7*pow(q,6) + 2.5*pow(q,7); } );
                     calcDielectric = [&](double M2V) { return 1 + 3*M2V; };
 		    selfenergy_prefactor = 0.875;
                 }
 
-                void sfFennel(const Tmjson &j) {
+                void sfFennel(const Tmjson &j, Tcache &cache) {
                     alpha = j.at("alpha");
-                    table = sf.generate( [&](double q) { return (erfc(alpha*rc*q) - erfc(alpha*rc)*q + (q-1.0)*q*(erfc(alpha*rc) + 2 * alpha * rc / sqrt(pc::pi) * exp(-alpha*alpha*rc*rc))); } );
+                    table = generate( cache, [&](double q) { return (erfc(alpha*rc*q) - erfc(alpha*rc)*q + (q-1.0)*q*(erfc(alpha*rc) + 2 * alpha * rc / sqrt(pc::pi) * exp(-alpha*alpha*rc*rc))); } );
 		    calcDielectric = [&](double M2V) { double T = erf(alpha*rc) - (2 / (3 * sqrt(pc::pi))) * exp(-alpha*alpha*rc*rc) * (alpha*alpha*rc*rc * alpha*alpha*rc*rc + 2.0 * alpha*alpha*rc*rc + 3.0);
 						       return (((T + 2.0) * M2V + 1.0)/ ((T - 1.0) * M2V + 1.0)); };
 		    selfenergy_prefactor = ( erfc(alpha*rc)/2.0 + alpha*rc/sqrt(pc::pi) );
                 }
 
-                void sfWolf(const Tmjson &j) {
+                void sfWolf(const Tmjson &j, Tcache &cache) {
                     alpha = j.at("alpha");
-                    table = sf.generate( [&](double q) { return (erfc(alpha*rc*q) - erfc(alpha*rc)*q); } );
+                    table = generate( cache, [&](double q) { return (erfc(alpha*rc*q) - erfc(alpha*rc)*q); } );
 		    calcDielectric = [&](double M2V) { double T = erf(alpha*rc) - (2 / (3 * sqrt(pc::pi))) * exp(-alpha*alpha*rc*rc) * ( 2.0 * alpha*alpha*rc*rc + 3.0);
 						       return (((T + 2.0) * M2V + 1.0)/ ((T - 1.0) * M2V + 1.0));};
 		    selfenergy_prefactor = ( erfc(alpha*rc) + alpha*rc/sqrt(pc::pi)*(1.0 + exp(-alpha*alpha*rc2)) );
                 }
 
-                void sfPlain(const Tmjson &j, double val=1) {
-                    table = sf.generate( [&](double q) { return val; } );
+                void sfPlain(const Tmjson &j, Tcache &cache, double val=1) {
+                    table = generate( cache, [&](double q) { return val; } );
 		    calcDielectric = [&](double M2V) { return (2.0*M2V + 1.0)/(1.0 - M2V); };
 		    selfenergy_prefactor = 0.0;
                 }
@@ -500,19 +521,28 @@ namespace Faunus {
                         lB = pc::lB( epsr );
                         depsdt = j.value("depsdt", -0.368*pc::T()/epsr);
 
+                        string tabtype = j.value("tab_type", string("andrea"));
+                        if (tabtype!="andrea" && tabtype!="uniform")
+                            throw std::runtime_error("unknown tab_type '" + tabtype + "'");
+                        uniform = (tabtype=="uniform");
                         sf.setRange(0, 1);
                         sf.setTolerance(
                                 j.value("tab_utol",1e-9),j.value("tab_ftol",1e-2) );
-
-                        if (type=="reactionfield") sfReactionField(j);
-                        if (type=="fanourgakis") sfFanourgakis(j);
-                        if (type=="qpotential") sfQpotential(j);
-                        if (type=="yonezawa") sfYonezawa(j);
-                        if (type=="yukawa") sfYukawa(j);
-                        if (type=="fennel") sfFennel(j);
-                        if (type=="plain") sfPlain(j,1);
-                        if (type=="none") sfPlain(j,0);
-                        if (type=="wolf") sfWolf(j);
+                        sfu.setRange(0, 1);
+                        sfu.setTolerance(
+                                j.value("tab_utol",1e-9),j.value("tab_ftol",1e-2) );
+                        Tcache cache( j.value("tab_cache", string()) );
+
+                        if (type=="reactionfield") sfReactionField(j,cache);
+                        if (type=="fanourgakis") sfFanourgakis(j,cache);
+                        if (type=="qpotential") sfQpotential(j,cache);
+                        if (type=="yonezawa") sfYonezawa(j,cache);
+                        if (type=="yukawa") sfYukawa(j,cache);
+                        if (type=="fennel") sfFennel(j,cache);
+                        if (type=="plain") sfPlain(j,cache,1);
+                        if (type=="none") sfPlain(j,cache,0);
+                        if (type=="wolf") sfWolf(j,cache);
+                        cache.save();
 
                         if ( table.empty() )
                             throw std::runtime_error("unknown coulomb type '" + type + "'" );
@@ -529,7 +559,7 @@ namespace Faunus {
                     double operator()(const Tparticle &a, const Tparticle &b, double r2) const {
                         if (r2 < rc2) {
                             double r = sqrt(r2);
-                            return lB * a.charge * b.charge / r * sf.eval( table, r*rc1i );
+                            return lB * a.charge * b.charge / r * splitting( r*rc1i );
                         }
                         return 0;
                     }
@@ -539,11 +569,29 @@ namespace Faunus {
                         return operator()(a,b,r.squaredNorm());
                     }
 
+                /**
+                 * @brief Energy of `a` with particles `beg` to `end-1` of a structure of arrays
+                 * @param r2 Squared distances, `r2[j-beg]` for particle `j`
+                 */
+                template<class Tparticle, class Tarrays>
+                    double batch(const Tparticle &a, const Tarrays &b, const double *r2, int beg, int end) const {
+                        if (a.charge == 0)
+                            return 0;
+                        const double *q = b.charge.data() + beg;
+                        double u = 0;
+                        for (int k=0; k<end-beg; k++)
+                            if (r2[k] < rc2 && q[k] != 0) {
+                                double r = sqrt(r2[k]);
+                                u += q[k] / r * splitting( r*rc1i );
+                            }
+                        return lB * a.charge * u;
+                    }
+
                 template<typename Tparticle>
                     Point force(const Tparticle &a, const Tparticle &b, double r2, const Point &p) {
                         if (r2 < rc2) {
                             double r = sqrt(r2);
-                            return lB * a.charge * b.charge * ( -sf.eval( table, r*rc1i )/r2 + sf.evalDer( table, r*rc1i )/r )*p;
+                            return lB * a.charge * b.charge * ( -splitting( r*rc1i )/r2 + splittingDer( r*rc1i )/r )*p;
                         }
                         return Point(0,0,0);
                     }
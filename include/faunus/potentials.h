@@ -10,6 +10,7 @@
 #include <faunus/inputfile.h>
 #include <faunus/species.h>
 #include <faunus/average.h>
+#include <array>
 #endif
 
 namespace Faunus {
@@ -56,6 +57,9 @@ namespace Faunus {
 
     class DebyeHuckel;
 
+    /** @brief Pair energy split into inverse powers of the distance, `t[n]` for \f$ r^{-n} \f$. See `PowerLaw`. */
+    typedef std::array<double,13> PowerTerms;
+
     /**
      * @brief Base class for pair potential classes
      *
@@ -113,6 +117,17 @@ namespace Faunus {
         template<class Tspace>
           void setSpace(Tspace&) {}
 
+        /**
+         * @brief Update geometry dependent features for the geometry `g` bound for energy evaluation
+         *
+         * Called when the energy is bound to another geometry of the space,
+         * e.g. `Space::geo_trial` during volume moves, see
+         * `Energy::Energybase::setGeometry()`. Unlike `setSpace()` this should
+         * not update any averages. The base-class version does nothing.
+         */
+        template<class Tspace, class Tgeometry>
+          void setGeometry(Tspace&, Tgeometry&) {}
+
         virtual void test(UnitTest&);                    //!< Perform unit test
 
         virtual std::string info(char=20);
@@ -672,6 +687,14 @@ namespace Faunus {
             double x(r6(a.radius+b.radius,r2));
             return eps*(x*x - x);
           }
+
+        /** @brief Add energy to `t[12]` and `t[6]`, see `PowerLaw` */
+        template<class Tparticle>
+          void powerTerms(const Tparticle &a, const Tparticle &b, double r2, PowerTerms &t) const {
+            double x(r6(a.radius+b.radius,r2));
+            t[12] += eps*x*x;
+            t[6] -= eps*x;
+          }
         template<class Tparticle>
           double operator() (const Tparticle &a, const Tparticle &b, const Point &r) {
             return operator()(a,b,r.squaredNorm());
@@ -823,6 +846,32 @@ namespace Faunus {
               return eps(a.id,b.id) * (x*x - x);
             }
 
+          /** @brief Add energy to `t[12]` and `t[6]`, see `PowerLaw` */
+          template<class Tparticle>
+            void powerTerms(const Tparticle &a, const Tparticle &b, double r2, PowerTerms &t) const {
+              double x=s2(a.id,b.id)/r2;
+              x=x*x*x;
+              t[12] += eps(a.id,b.id) * x*x;
+              t[6] -= eps(a.id,b.id) * x;
+            }
+
+          /**
+           * @brief Energy of `a` with particles `beg` to `end-1` of a structure of arrays
+           * @param r2 Squared distances, `r2[j-beg]` for particle `j`
+           */
+          template<class Tparticle, class Tarrays>
+            double batch(const Tparticle &a, const Tarrays &b, const double *r2, int beg, int end) const {
+              const double *s2a = s2.m[a.id].data(), *epsa = eps.m[a.id].data();
+              const int *id = b.id.data() + beg;
+              double u = 0;
+              for (int k=0; k<end-beg; k++) {
+                double x=s2a[id[k]]/r2[k]; //s2/r2
+                x=x*x*x; // s6/r6
+                u += epsa[id[k]] * (x*x - x);
+              }
+              return u;
+            }
+
           template<typename Tparticle>
             Point force(const Tparticle &a, const Tparticle &b, double r2, const Point &p) {
               double s6=_powi<3>( s2(a.id,b.id) );
@@ -1120,6 +1169,15 @@ namespace Faunus {
             return eps*x*x;
           }
 
+        /** @brief Add energy to `t[12]`, see `PowerLaw` */
+        template<class Tparticle>
+          void powerTerms(const Tparticle &a, const Tparticle &b, double r2, PowerTerms &t) const {
+            double x=(a.radius+b.radius);
+            x=x*x/r2;
+            x=x*x*x;
+            t[12] += eps*x*x;
+          }
+
         string info(char);
     };
 
@@ -1138,6 +1196,13 @@ namespace Faunus {
             double x=r6(a.radius+b.radius,r2);
             return eps*x*x;
           }
+
+        /** @brief Add energy to `t[12]`, see `PowerLaw` */
+        template<class Tparticle>
+          void powerTerms(const Tparticle &a, const Tparticle &b, double r2, PowerTerms &t) const {
+            double x=r6(a.radius+b.radius,r2);
+            t[12] += eps*x*x;
+          }
     };
 
     /**
@@ -1210,6 +1275,12 @@ namespace Faunus {
 #endif
         }
 
+      /** @brief Add energy to `t[1]`, see `PowerLaw` */
+      template<class Tparticle>
+        void powerTerms(const Tparticle &a, const Tparticle &b, double r2, PowerTerms &t) const {
+          t[1] += operator()(a,b,r2);
+        }
+
       template<class Tparticle>
         double operator() (const Tparticle &a, const Tparticle &b, const Point &r) {
           return operator()(a,b,r.squaredNorm());
@@ -1486,20 +1557,36 @@ namespace Faunus {
             return std::sinh(ka)/ka*p.charge;
           }
 
+        /**
+         * @brief Adds counter ions in volume `V` to kappa
+         */
+        template<class Tspace>
+          void updateCounterIons(Tspace &s, double V) {
+            double N=netCharge(s.p.begin(), s.p.end()) / std::fabs(z_count);
+            double k2=k*k - k2_count; // salt contribution
+            k2_count = 4*pc::pi*lB*N/V*std::pow(z_count,2); // counter ion contrib
+            k=sqrt( k2+k2_count );    // total
+          }
+
         /**
          * @brief Adds counter ions to kappa
          */
         template<class Tspace>
           void setSpace(Tspace &s) {
             if (std::fabs(z_count)>1e-6) {
-              double N=netCharge(s.p.begin(), s.p.end()) / std::fabs(z_count);
-              double V=s.geo.getVolume();
-              double k2=k*k - k2_count; // salt contribution
-              k2_count = 4*pc::pi*lB*N/V*std::pow(z_count,2); // counter ion contrib
-              k=sqrt( k2+k2_count );    // total
+              updateCounterIons(s, s.geo.getVolume());
               k2_count_avg+=k2_count;   // sample average
             }
           }
+
+        /**
+         * @brief Counter ion screening in the volume of `g`, e.g. the trial volume of a volume move
+         */
+        template<class Tspace, class Tgeometry>
+          void setGeometry(Tspace &s, Tgeometry &g) {
+            if (std::fabs(z_count)>1e-6)
+              updateCounterIons(s, g.getVolume());
+          }
     };
     /**
      * @brief Debye-Huckel potential
@@ -1781,6 +1868,10 @@ namespace Faunus {
      *
      * If the pair is not recognized, i.e. not added with the
      * `add()` function, the `Tdefault` pair potential is used.
+     * Custom potentials are looked up in a dense, symmetric
+     * type-by-type table that is filled by `add()` so that each
+     * pair evaluation costs a single array access. Default pairs
+     * call `Tdefault` directly without going through `std::function`.
      *
      * Example:
      *
@@ -1791,11 +1882,11 @@ namespace Faunus {
     template<typename Tdefault, typename Tparticle=PointParticle, typename Tdist=double>
       class PotentialMap : public Tdefault {
         protected:
-          typedef opair<int> Tpair;
           typedef std::function<double(const Tparticle&,const Tparticle&,Tdist)> Tfunc;
           typedef std::function<Point(const Tparticle&,const Tparticle&,double,const Point&)> Tforce;
-          std::map<Tpair,Tfunc> m;
-          std::map<Tpair,Tforce> mforce;
+          std::vector<Tfunc> func;      // custom energy functors
+          std::vector<Tforce> forcefunc; // custom force functors
+          PairMatrix<int> index;        // 1 + index into `func`; 0 = default
           std::string _info; // info for the added potentials (before turning into functors)
 
           // Force function object wrapper class
@@ -1821,21 +1912,38 @@ namespace Faunus {
             void add(AtomData::Tid id1, AtomData::Tid id2, Tpairpot pot) {
               pot.name=atom[id1].name + "<->" + atom[id2].name + ": " + pot.name;
               _info+="\n  " + pot.name + ":\n" + pot.info(20);
-              m[Tpair(id1,id2)] = pot;
-              mforce[Tpair(id1,id2)] = ForceFunctionObject<decltype(pot)>(pot);
+              int k = lookup(id1,id2);
+              if (k==0) {
+                func.push_back( pot );
+                forcefunc.push_back( ForceFunctionObject<decltype(pot)>(pot) );
+                k = func.size();
+                index.set(id1, id2, k);
+                if (index.size()<atom.size())
+                  index.resize(atom.size());
+              } else {
+                func[k-1] = pot;
+                forcefunc[k-1] = ForceFunctionObject<decltype(pot)>(pot);
+              }
             }
 
+          /** @brief One plus index of custom potential for pair; zero if default */
+          int lookup(AtomData::Tid i, AtomData::Tid j) const {
+            if (size_t(i)<index.size() && size_t(j)<index.size())
+              return index.m[i][j];
+            return 0;
+          }
+
           double operator()(const Tparticle &a, const Tparticle &b, const Tdist &r2) {
-            auto i=m.find( Tpair(a.id,b.id) );
-            if (i!=m.end())
-              return i->second(a,b,r2);
+            int k = lookup(a.id,b.id);
+            if (k!=0)
+              return func[k-1](a,b,r2);
             return Tdefault::operator()(a,b,r2);
           }
 
           Point force(const Tparticle &a, const Tparticle &b, double r2, const Point &p) {
-            auto i=mforce.find( Tpair(a.id,b.id) );
-            if (i!=mforce.end())
-              return i->second(a,b,r2,p);
+            int k = lookup(a.id,b.id);
+            if (k!=0)
+              return forcefunc[k-1](a,b,r2,p);
             return Tdefault::force(a,b,r2,p);
           }
 
@@ -1901,6 +2009,20 @@ namespace Faunus {
               return first(a,b,r2) + second(a,b,r2);
             }
 
+          /** @brief Batched energy; only available if both potentials provide `batch()` */
+          template<class Tparticle, class Tarrays, class U1=T1, class U2=T2>
+            auto batch(const Tparticle &a, const Tarrays &b, const double *r2, int beg, int end)
+            -> decltype(std::declval<U1&>().batch(a,b,r2,beg,end) + std::declval<U2&>().batch(a,b,r2,beg,end)) {
+              return first.batch(a,b,r2,beg,end) + second.batch(a,b,r2,beg,end);
+            }
+
+          /** @brief Inverse power terms; only valid if `PowerLaw` is true for both potentials */
+          template<class Tparticle>
+            void powerTerms(const Tparticle &a, const Tparticle &b, double r2, PowerTerms &t) const {
+              first.powerTerms(a,b,r2,t);
+              second.powerTerms(a,b,r2,t);
+            }
+
           template<typename Tparticle>
             Point force(const Tparticle &a, const Tparticle &b, double r2, const Point &p) {
               return first.force(a,b,r2,p) + second.force(a,b,r2,p);
@@ -1922,6 +2044,12 @@ namespace Faunus {
               second.setSpace(s);
             }
 
+          template<class Tspace, class Tgeometry>
+            void setGeometry(Tspace &s, Tgeometry &g) {
+              first.setGeometry(s, g);
+              second.setGeometry(s, g);
+            }
+
           string info(char w=20) {
             return first.info(w) + second.info(w);
           }
@@ -1932,6 +2060,31 @@ namespace Faunus {
           }
       };
 
+    /**
+     * @brief Test if pair potential is a sum of inverse powers of the distance
+     *
+     * If true, `Tpairpot::powerTerms()` splits the pair energy into terms
+     * \f$ u_n \propto r^{-n} \f$ so that the energy after scaling all
+     * distances by `s` is \f$ \sum_n u_n s^{-n} \f$. Only the plain
+     * potentials are listed; derived classes such as `LennardJonesTrunkShift`
+     * or `CutShift` change the distance dependence.
+     */
+    template<class Tpairpot>
+      struct PowerLaw { static const bool value = false; };
+
+    template<> struct PowerLaw<Coulomb> { static const bool value = true; };
+    template<> struct PowerLaw<LennardJones> { static const bool value = true; };
+    template<> struct PowerLaw<LennardJonesR12> { static const bool value = true; };
+    template<> struct PowerLaw<R12Repulsion> { static const bool value = true; };
+
+    template<class Tmixingrule>
+      struct PowerLaw<LennardJonesMixed<Tmixingrule>> { static const bool value = true; };
+
+    template<class T1, class T2>
+      struct PowerLaw<CombinedPairPotential<T1,T2>> {
+        static const bool value = PowerLaw<T1>::value && PowerLaw<T2>::value;
+      };
+
     /**
      * @brief Creates a new pair potential with opposite sign
      */
@@ -1988,6 +2141,24 @@ namespace Faunus {
           return *(new CombinedPairPotential<T1,T2>(pot1,pot2));
         }
 
+    /**
+     * @brief Sum of an arbitrary number of pair potentials
+     *
+     * Nests `CombinedPairPotential` so that a single pair loop with
+     * one distance calculation feeds all terms.
+     *
+     *     typedef PairPotentialSum<CoulombGalore, LennardJonesLB, HardSphere>::type Tpairpot;
+     */
+    template<class T1, class... Tn>
+      struct PairPotentialSum {
+        typedef CombinedPairPotential<T1, typename PairPotentialSum<Tn...>::type> type;
+      };
+
+    template<class T1>
+      struct PairPotentialSum<T1> {
+        typedef T1 type;
+      };
+
     /**
      * @brief Subtracts two pair potentials
      *
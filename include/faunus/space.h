@@ -216,6 +216,64 @@ namespace Faunus
 
   };
 
+  /**
+   * @brief Structure-of-arrays copy of particle positions, charges and ids
+   *
+   * Pair loops that need only positions, charges and atom types may
+   * iterate over these contiguous arrays rather than over the particle
+   * vector which, depending on the particle type, carries much more data
+   * per particle. See `Space::enableArrays()`.
+   */
+  struct ParticleArrays
+  {
+      std::vector<double> x, y, z, charge;
+      std::vector<int> id;
+
+      size_t size() const { return id.size(); }
+
+      void resize( size_t n )
+      {
+          x.resize(n);
+          y.resize(n);
+          z.resize(n);
+          charge.resize(n);
+          id.resize(n);
+      }
+
+      /** @brief Copy data from particle `a` into element `i` */
+      template<class Tparticle>
+      void set( int i, const Tparticle &a )
+      {
+          x[i] = a.x();
+          y[i] = a.y();
+          z[i] = a.z();
+          charge[i] = a.charge;
+          id[i] = a.id;
+      }
+
+      /** @brief Copy data from particle vector */
+      template<class Tpvec>
+      void assign( const Tpvec &p )
+      {
+          resize(p.size());
+          for ( size_t i = 0; i < p.size(); i++ )
+              set(i, p[i]);
+      }
+
+      /** @brief True if data equals that of particle vector (for assertions) */
+      template<class Tpvec>
+      bool matches( const Tpvec &p ) const
+      {
+          if ( p.size() != size())
+              return false;
+          for ( size_t i = 0; i < p.size(); i++ )
+              if ( x[i] != p[i].x() || y[i] != p[i].y() || z[i] != p[i].z()
+                  || charge[i] != p[i].charge || id[i] != p[i].id )
+                  return false;
+          return true;
+      }
+  };
+
   /**
    * @brief Placeholder for particles and groups
    *
@@ -253,7 +311,13 @@ namespace Faunus
   private:
       bool checkSanity();                    //!< Check group length and vector sync
       std::vector<Group *> g;                 //!< Pointers to ALL groups in the system
+      std::vector<int> gindex;               //!< Index in `g` of the group of each particle (-1 if none)
       Tmjson to_json();
+      bool useArrays = false;                //!< Keep `ParticleArrays` mirrors in sync?
+      ParticleArrays soa;                    //!< Mirror of `p`
+      ParticleArrays soa_trial;              //!< Mirror of `trial`
+      std::vector<int> changelog;            //!< Particles touched by moves, see `changeLog()`
+      unsigned int changeepoch = 0;          //!< Incremented whenever `changelog` is reset
 
   public:
       typedef std::vector<Tparticle, Eigen::aligned_allocator<Tparticle> > p_vec;
@@ -292,7 +356,7 @@ namespace Faunus
           std::map<int, vector<int>> rmGroup; // remove groups
           std::map<int, ParticleVector> inGroup; // insert groups
 
-          Change() : dV(0) {};
+          Change() : dV(0), geometryChange(false) {};
 
           void clear()
           {
@@ -333,16 +397,128 @@ namespace Faunus
                       assert(g->find(i));
                       p[i] = trial[i];
                   }
-              if ( c.geometryChange )
-              {
-                  g.setMassCenter(p, geo_trial); // update mass center
-              }
+              g->cm = Geometry::massCenter(c.geometryChange ? geo_trial : geo, p, *g); // update mass center
+              g->cm_trial = g->cm;
+          }
+          assert(c.rmGroup.empty() && c.inGroup.empty() && "incomplete");
+          syncArrays(c);
+      }
+
+      /**
+       * @brief Enable `ParticleArrays` mirrors of `p` and `trial`
+       *
+       * Once enabled, the mirrors are updated by `syncArrays()` which
+       * is called by `Move::Movebase::move()` after each trial move and
+       * after acceptance or rejection, as well as by `load()`, `insert()`,
+       * `erase()` and `eraseGroup()`. Code that assigns to `p` or `trial`
+       * directly must call `enableArrays()` again before the next energy
+       * evaluation; stale mirrors are caught by an assertion in `arrays()`.
+       */
+      void enableArrays()
+      {
+          useArrays = true;
+          soa.assign(p);
+          soa_trial.assign(trial);
+      }
+
+      /**
+       * @brief Update mirrors and change log for all particles touched by change
+       *
+       * An empty change is taken to mean that the move does not
+       * report what it changed, and all particles are copied.
+       */
+      void syncArrays( const Change &c )
+      {
+          logChange(c);
+          if ( !useArrays )
+              return;
+          if ( c.empty() || c.geometryChange || !c.inGroup.empty() || !c.rmGroup.empty()
+              || soa.size() != p.size() || soa_trial.size() != trial.size())
+          {
+              soa.assign(p);
+              soa_trial.assign(trial);
+              return;
+          }
+          for ( auto &m : c.mvGroup )
+              if ( m.second.empty())
+                  for ( auto i : *groupList().at(m.first))
+                  {
+                      soa.set(i, p[i]);
+                      soa_trial.set(i, trial[i]);
+                  }
               else
-              {
-                  g.setMassCenter(p, geo); // update mass center
-              }
+                  for ( auto i : m.second )
+                  {
+                      soa.set(i, p[i]);
+                      soa_trial.set(i, trial[i]);
+                  }
+      }
+
+      /**
+       * @brief Append particles touched by change to `changeLog()`
+       *
+       * Called by `syncArrays()`. Unknown changes (empty), geometry changes,
+       * insertions and deletions reset the log, as does a log that grows
+       * beyond the number of particles.
+       */
+      void logChange( const Change &c )
+      {
+          if ( c.empty() || c.geometryChange || !c.inGroup.empty() || !c.rmGroup.empty())
+          {
+              resetChangeLog();
+              return;
           }
-          assert(!"incomplete");
+          for ( auto &m : c.mvGroup )
+              if ( m.second.empty())
+                  for ( auto i : *groupList().at(m.first))
+                      changelog.push_back(i);
+              else
+                  changelog.insert(changelog.end(), m.second.begin(), m.second.end());
+          if ( changelog.size() > p.size())
+              resetChangeLog();
+      }
+
+      /**
+       * @brief Clear `changeLog()` and increment `changeEpoch()`
+       *
+       * Done by `load()`, `insert()`, `erase()` and `eraseGroup()`. Code
+       * that assigns to `p` directly must call this before the next move.
+       */
+      void resetChangeLog()
+      {
+          changelog.clear();
+          changeepoch++;
+      }
+
+      /**
+       * @brief Index of particles touched by moves since the last reset
+       *
+       * Particles are logged by `syncArrays()` after each trial move and
+       * after acceptance or rejection, so entries may repeat and may refer
+       * to particles that were restored. Derived data of `p`, for example
+       * `Geometry::SyncedCellList`, can be kept up to date by processing
+       * entries appended since the previous visit, or by a rebuild if
+       * `changeEpoch()` has changed in the meantime.
+       */
+      const std::vector<int> &changeLog() const { return changelog; }
+
+      unsigned int changeEpoch() const { return changeepoch; } //!< Incremented whenever `changeLog()` is reset
+
+      /**
+       * @brief Mirror of particle vector `v` which must be either `p` or `trial`
+       *
+       * `enableArrays()` must have been called. If the number of particles
+       * has changed the mirror is rebuilt.
+       */
+      const ParticleArrays &arrays( const ParticleVector &v )
+      {
+          assert(useArrays && "Particle arrays not enabled");
+          assert((&v == &p || &v == &trial) && "Particle vector not in Space");
+          ParticleArrays &a = (&v == &p) ? soa : soa_trial;
+          if ( a.size() != v.size())
+              a.assign(v);
+          assert(a.matches(v) && "Particle arrays out of sync - call enableArrays() after direct edits");
+          return a;
       }
 
       /**
@@ -382,6 +558,7 @@ namespace Faunus
       bool insert( const Tparticle &, int= -1 ); //!< Insert particle at pos n (old n will be pushed forward).
       bool erase( int );             //!< Remove n'th particle and downshift/remove groups
       bool eraseGroup( int );        //!< Remove n'th group as well as its particles
+      void updateGroupIndex();       //!< Rebuild particle-to-group table; call after editing `groupList()` directly
       void reserve( int );           //!< Reserve space for particles for better memory efficiency
       string info();               //!< Information string
 
@@ -410,19 +587,33 @@ namespace Faunus
               for ( auto i : *g )
                   atomTrack.insert(p.at(i).id, i);
           }
+          updateGroupIndex();
       }
 
       /**
        * @brief Find which group given particle index belongs to.
        *
-       * If not found, `nullptr` is returned.
+       * The lookup is made in a particle-to-group table maintained by
+       * `insert()`, `erase()`, `eraseGroup()` and `initTracker()`. If
+       * `groupList()` is modified directly, `updateGroupIndex()` must be
+       * called before the next lookup. The lookup does not modify the
+       * table and may be used from parallel loops. If the particle is in
+       * no group, `nullptr` is returned; if the table is out of date, an
+       * exception is thrown.
        */
-      inline Group *findGroup( int i )
+      inline Group *findGroup( int i ) const
       {
-          for ( auto g : groupList())
-              if ( g->find(i))
-                  return g;
-          return nullptr;
+          if ( i < 0 || i >= (int) p.size())
+              return nullptr;
+          if ( i < (int) gindex.size())
+          {
+              int k = gindex[i];
+              if ( k >= 0 && k < (int) g.size() && g[k]->find(i))
+                  return g[k];
+              if ( k < 0 && std::none_of(g.begin(), g.end(), [i]( Group *gi ) { return gi->find(i); }))
+                  return nullptr;
+          }
+          throw std::runtime_error("Space: group index out of date - call updateGroupIndex()");
       }
 
       /**
@@ -432,6 +623,16 @@ namespace Faunus
        */
       inline int findIndex( Group *group )
       {
+          if ( group != nullptr && !group->empty())
+          {
+              int i = group->front();
+              if ( i >= 0 && i < (int) gindex.size())
+              {
+                  int k = gindex[i];
+                  if ( k >= 0 && k < (int) g.size() && g[k] == group )
+                      return k;
+              }
+          }
           auto it = std::find(g.begin(), g.end(), group);
           return (it != g.end()) ? it - g.begin() : -1;
       }
@@ -590,6 +791,20 @@ namespace Faunus
       return rc;
   }
 
+  /**
+   * If groups overlap, particles are assigned to the first group
+   * in `groupList()`, as for a linear search.
+   */
+  template<class Tgeometry, class Tparticle>
+  void Space<Tgeometry, Tparticle>::updateGroupIndex()
+  {
+      gindex.assign(p.size(), -1);
+      for ( int k = (int) g.size() - 1; k >= 0; k-- )
+          for ( auto i : *g[k] )
+              if ( i >= 0 && i < (int) gindex.size())
+                  gindex[i] = k;
+  }
+
   /**
    * @param a Particle to insert
    * @param i Insert position in particle vector. Old i will be pushed forward.
@@ -630,6 +845,10 @@ namespace Faunus
           if ( gj->back() >= i )
               gj->setback(gj->back() + 1);    //gj->last++; // +1 is a special case for adding to the end of p-vector
       }
+      updateGroupIndex();
+      resetChangeLog();
+      if ( useArrays )
+          enableArrays();
       return true;
   }
 
@@ -669,6 +888,10 @@ namespace Faunus
                   if ( j > i )
                       j--;
 
+          updateGroupIndex();
+          resetChangeLog();
+          if ( useArrays )
+              enableArrays();
           return true;
       }
       return false;
@@ -727,6 +950,10 @@ namespace Faunus
               }
 
           assert(atomTrack.size() == p.size());
+          updateGroupIndex();
+          resetChangeLog();
+          if ( useArrays )
+              enableArrays();
           return true;
       }
       return false;
@@ -873,6 +1100,9 @@ namespace Faunus
               geo_trial = geo;
 
               initTracker(); // update trackers
+              resetChangeLog();
+              if ( useArrays )
+                  enableArrays();
 
               checkSanity();
 
@@ -994,6 +1224,10 @@ namespace Faunus
 
                   assert(atomTrack.size() == p.size());
 
+                  updateGroupIndex();
+                  resetChangeLog();
+                  if ( useArrays )
+                      enableArrays();
                   return g[imax];
               }
           }
@@ -1023,6 +1257,10 @@ namespace Faunus
 
           x->setMassCenter(*this);
 
+          gindex.resize(p.size(), g.size() - 1);
+          resetChangeLog();
+          if ( useArrays )
+              enableArrays();
           return x;
       }
       return nullptr;
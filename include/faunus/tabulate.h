@@ -12,6 +12,11 @@
 #include <algorithm>
 #include <cmath>
 #include <memory>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <typeinfo>
 
 #include <faunus/potentials.h>
 
@@ -42,6 +47,13 @@ namespace Faunus
         T utol, ftol, umaxtol, fmaxtol, rmin, rmax;
         T numdr; // dr for derivative evaluation
 
+        static void hash( uint64_t &h, const void *p, size_t n )
+        { // FNV-1a
+            const unsigned char *c = static_cast<const unsigned char *>(p);
+            for ( size_t i = 0; i < n; i++ )
+                h = (h ^ c[i]) * 1099511628211ULL;
+        }
+
         // First derivative with respect to x
         T f1( std::function<T( T )> &f, T x ) const
         {
@@ -113,6 +125,41 @@ namespace Faunus
             numdr = _numdr;
         }
 
+        /**
+         * @brief Distance at fraction `s` of the range [lo,hi]
+         *
+         * Distances are spaced geometrically, if possible, so that samples
+         * resolve the short range part of a potential as well as the tail.
+         */
+        static T sample( T lo, T hi, T s )
+        {
+            return (lo > 0) ? lo * std::pow(hi / lo, s) : lo + (hi - lo) * s;
+        }
+
+        /**
+         * @brief Content key of a table of `f` with the current range and tolerances
+         *
+         * The 64-bit key is a hash of `tag`, the tabulation settings and `f`
+         * sampled at 64 distances in the range, see `sample()`. Used by `TableCache`.
+         */
+        uint64_t key( std::function<T( T )> &f, const std::string &tag = "" ) const
+        {
+            uint64_t h = 14695981039346656037ULL;
+            hash(h, tag.data(), tag.size());
+            for ( T x : {utol, ftol, umaxtol, fmaxtol, rmin, rmax, numdr} )
+                hash(h, &x, sizeof(x));
+            const int n = 64;
+            for ( int i = 0; i < n; i++ )
+            {
+                T r = sample(rmin, rmax, (i + 0.5) / n);
+                T u = f(r * r);
+                hash(h, &u, sizeof(u));
+            }
+            return h;
+        }
+
+        T tolerance() const { return utol; } //!< Energy tolerance, `utol`
+
         TabulatorBase()
         {
             utol = 0.01;
@@ -1249,6 +1296,309 @@ namespace Faunus
         }
     };
 
+    /**
+     * @brief Cubic Hermite table on a uniform grid with constant time lookup
+     *
+     * The interval [`rmin`,`rmax`] of the tabulated variable (typically
+     * \f$ r^2 \f$) is divided into equally sized bins so that the bin of a
+     * given `x` is found by a single multiplication and truncation instead
+     * of a search. Each bin is a record of four interleaved polynomial
+     * coefficients (32 bytes for `double`), from which both the value and
+     * the derivative are evaluated, so a lookup touches a single record.
+     * The number of bins is doubled until `utol` (and `ftol`, if set) is met
+     * at the interior points of all bins.
+     *
+     * Layout of the table data:
+     *
+     * - `r2` holds \f$ x_{min} \f$, \f$ 1/\Delta x \f$ and \f$ \Delta x \f$
+     * - `c` holds one record below the range, the bins, and one record above the range
+     *
+     * Values outside the range are the boundary values or, for tables made by
+     * `generate_full()`, a large number below and zero above the range.
+     */
+    template<typename T=double>
+    class Uniform : public TabulatorBase<T>
+    {
+    private:
+        typedef TabulatorBase<T> base; // for convenience
+        int maxbins; // Max number of bins
+
+        /** @brief Record index for x; 0 is below and n+1 above the range */
+        int bin( const typename base::data &d, T x, T &dz ) const
+        {
+            T z = (x - d.r2[0]) * d.r2[1];
+            int last = int(d.c.size() / 4) - 1;
+            int i = (z < 0) ? 0 : (z >= last - 1) ? last : int(z) + 1;
+            dz = x - (d.r2[0] + (i - 1) * d.r2[2]);
+            return i;
+        }
+
+        /** @brief Largest deviation from `f` in units of the tolerances; <=1 is within tolerance */
+        T error( const typename base::data &d, std::function<T( T )> &f, int n ) const
+        {
+            T err = 0;
+            for ( int i = 0; i < n; i++ )
+                for ( T s : {0.25, 0.5, 0.75} )
+                {
+                    T x = d.r2[0] + (i + s) * d.r2[2];
+                    err = std::max(err, std::abs(eval(d, x) - f(x)) / base::utol);
+                    if ( base::ftol != -1 )
+                        err = std::max(err, std::abs(evalDer(d, x) - base::f1(f, x)) / base::ftol);
+                }
+            return err;
+        }
+
+    public:
+        Uniform() : base()
+        {
+            maxbins = 1 << 18;
+        }
+
+        /**
+         * @brief Get tabulated value at f(x)
+         * @param d Table data
+         * @param x x value
+         */
+        T eval( const typename base::data &d, T x ) const
+        {
+            T dz;
+            const T *c = &d.c[4 * bin(d, x, dz)];
+            return c[0] + dz * (c[1] + dz * (c[2] + dz * c[3]));
+        }
+
+        /**
+         * @brief Get tabulated value at df(x)/dx
+         * @param d Table data
+         * @param x x value
+         */
+        T evalDer( const typename base::data &d, T x ) const
+        {
+            T dz;
+            const T *c = &d.c[4 * bin(d, x, dz)];
+            return c[1] + dz * (2 * c[2] + dz * 3 * c[3]);
+        }
+
+        /**
+         * @brief Tabulate f(x)
+         *
+         * If `umaxtol` is set, the lower end of the range is raised to where
+         * \f$ |f| \f$ drops below `umaxtol`, cf. the repulsive cut in `Andrea`.
+         */
+        typename base::data generate( std::function<T( T )> f )
+        {
+            base::check();
+            T xmin = base::rmin * base::rmin;
+            T xmax = base::rmax * base::rmax;
+            if ( base::umaxtol != -1 && std::abs(f(xmin)) > base::umaxtol )
+            {
+                T lo = xmin, hi = xmax;
+                for ( int i = 0; i < 60; i++ )
+                {
+                    T mid = 0.5 * (lo + hi);
+                    if ( std::abs(f(mid)) > base::umaxtol )
+                        lo = mid;
+                    else
+                        hi = mid;
+                }
+                xmin = hi;
+            }
+
+            typename base::data td;
+            td.rmin2 = xmin;
+            td.rmax2 = xmax;
+            for ( int n = 16; ; n *= 2 )
+            {
+                assert(n <= maxbins && "Try to increase utol or ftol");
+                T dx = (xmax - xmin) / n;
+                td.r2 = {xmin, 1 / dx, dx};
+                td.c.assign(4 * (n + 2), 0);
+                T u0 = f(xmin), d0 = base::f1(f, xmin);
+                for ( int i = 1; i <= n; i++ )
+                {
+                    T x1 = xmin + i * dx;
+                    T u1 = f(x1), d1 = base::f1(f, x1);
+                    T s = (u1 - u0) / dx;
+                    T *c = &td.c[4 * i];
+                    c[0] = u0;
+                    c[1] = d0;
+                    c[2] = (3 * s - 2 * d0 - d1) / dx;
+                    c[3] = (d0 + d1 - 2 * s) / (dx * dx);
+                    u0 = u1;
+                    d0 = d1;
+                }
+                td.c[0] = f(xmin);    // below range
+                td.c[4 * (n + 1)] = u0; // above range
+                if ( error(td, f, n) <= 1 || n >= maxbins )
+                    break;
+            }
+            return td;
+        }
+
+        /**
+         * @brief Tabulate f(x) with a large value below and zero above the range
+         */
+        typename base::data generate_full( std::function<T( T )> f )
+        {
+            typename base::data tg = generate(f);
+            tg.c[0] = 100000;
+            tg.c[tg.c.size() - 4] = 0;
+            tg.rmin2 = 0;
+            tg.rmax2 = 1e9;
+            return tg;
+        }
+
+        /**
+         * @brief Table that is zero everywhere
+         */
+        typename base::data generate_empty()
+        {
+            typename base::data tg;
+            tg.rmin2 = 0;
+            tg.rmax2 = 1e10;
+            tg.r2 = {0, 1e-10, 1e10};
+            tg.c.assign(12, 0);
+            return tg;
+        }
+
+        std::string print( typename base::data &d )
+        {
+            std::ostringstream o;
+            o << "Bins: " << d.c.size() / 4 - 2 << endl
+              << "rmax2 r2=" << d.rmax2 << " r=" << sqrt(d.rmax2) << endl
+              << "rmin2 r2=" << d.rmin2 << " r=" << sqrt(d.rmin2) << endl
+              << "dr2=" << d.r2.at(2) << endl;
+            return o.str();
+        }
+    };
+
+    /**
+     * @brief Persistent cache of generated tables
+     *
+     * Tables are stored in a binary file and looked up by the content
+     * key of `TabulatorBase::key()` so that a table is only generated
+     * if the function, range, tolerances or tabulator changed. As the key
+     * samples the function at a finite number of points, a loaded table
+     * is also compared with the function at other points within its range
+     * and generated anew if it deviates by more than ten times `utol`.
+     * An empty file name disables the cache.
+     *
+     * Example:
+     *
+     *     TableCache<double> cache("tables.bin");
+     *     auto data = cache.generate(tab, f); // loaded or generated
+     *     cache.save();                       // write new tables to disk
+     *
+     * The file is replaced atomically by `save()` and tables written by other
+     * processes in the meantime are kept, so several replicas may share a file.
+     */
+    template<typename T=double>
+    class TableCache
+    {
+    private:
+        typedef typename TabulatorBase<T>::data Tdata;
+        std::string file;
+        std::map<uint64_t, Tdata> tables;
+        bool modified;
+        enum { version = 2 };
+
+        /** @brief True if table `d` matches `f` between the sample points of the key */
+        template<class Ttabulator>
+        static bool verify( const Ttabulator &tab, const Tdata &d, std::function<T( T )> &f )
+        {
+            const int n = 8;
+            T lo = std::sqrt(d.rmin2), hi = std::sqrt(d.rmax2);
+            for ( int i = 0; i < n; i++ )
+            {
+                T r = TabulatorBase<T>::sample(lo, hi, (i + 0.25) / n);
+                if ( std::abs(tab.eval(d, r * r) - f(r * r)) > 10 * tab.tolerance() )
+                    return false;
+            }
+            return true;
+        }
+
+        /** @brief Add tables from file that are not already in `m` */
+        void read( std::map<uint64_t, Tdata> &m ) const
+        {
+            std::ifstream f(file.c_str(), std::ios::binary);
+            char magic[8];
+            uint64_t ver;
+            if ( !f.read(magic, 8) || std::strncmp(magic, "FAUNTAB", 7) != 0 )
+                return;
+            if ( !f.read((char *) &ver, sizeof(ver)) || ver != version )
+                return;
+            uint64_t k, n[2];
+            Tdata d;
+            while ( f.read((char *) &k, sizeof(k)) )
+            {
+                if ( !f.read((char *) &d.rmin2, sizeof(T)) || !f.read((char *) &d.rmax2, sizeof(T)) )
+                    break;
+                if ( !f.read((char *) n, sizeof(n)) || n[0] > (1 << 26) || n[1] > (1 << 26) )
+                    break;
+                d.r2.resize(n[0]);
+                d.c.resize(n[1]);
+                if ( !f.read((char *) d.r2.data(), n[0] * sizeof(T)) || !f.read((char *) d.c.data(), n[1] * sizeof(T)) )
+                    break;
+                m.insert({k, d});
+            }
+        }
+
+    public:
+        TableCache( const std::string &filename = "" ) : file(filename), modified(false)
+        {
+            if ( !file.empty() )
+                read(tables);
+        }
+
+        size_t size() const { return tables.size(); } //!< Number of tables
+
+        /** @brief Table of `f` from the cache or, if not found, from `tab.generate()` */
+        template<class Ttabulator>
+        Tdata generate( Ttabulator &tab, std::function<T( T )> f )
+        {
+            if ( file.empty() )
+                return tab.generate(f);
+            uint64_t k = tab.key(f, typeid(Ttabulator).name());
+            auto it = tables.find(k);
+            if ( it != tables.end() && verify(tab, it->second, f) )
+                return it->second;
+            Tdata d = tab.generate(f);
+            tables[k] = d;
+            modified = true;
+            return d;
+        }
+
+        /** @brief Write tables to disk if any were generated */
+        void save()
+        {
+            if ( !modified || file.empty() )
+                return;
+            read(tables); // merge tables saved by others
+            std::string tmp = file + ".tmp" + std::to_string(std::random_device()());
+            std::ofstream f(tmp.c_str(), std::ios::binary);
+            uint64_t ver = version;
+            f.write("FAUNTAB\0", 8);
+            f.write((const char *) &ver, sizeof(ver));
+            for ( auto &i : tables )
+            {
+                uint64_t n[2] = {i.second.r2.size(), i.second.c.size()};
+                f.write((const char *) &i.first, sizeof(i.first));
+                f.write((const char *) &i.second.rmin2, sizeof(T));
+                f.write((const char *) &i.second.rmax2, sizeof(T));
+                f.write((const char *) n, sizeof(n));
+                f.write((const char *) i.second.r2.data(), n[0] * sizeof(T));
+                f.write((const char *) i.second.c.data(), n[1] * sizeof(T));
+            }
+            f.close();
+            if ( f && std::rename(tmp.c_str(), file.c_str()) == 0 )
+                modified = false;
+            else
+            {
+                std::remove(tmp.c_str());
+                std::cerr << "TableCache: could not write " << file << std::endl;
+            }
+        }
+    };
+
   } //Tabulate namespace
 
 #ifdef FAUNUS_POTENTIAL_H
@@ -1258,26 +1608,40 @@ namespace Faunus
 
     /**
      * @brief Tabulated potential between all particle types
+     *
+     * The tabulator is given by `Ttabulator` unless `tab_type` is set to
+     * `uniform` in which case `Tabulate::Uniform` is used.
      */
     template<typename Tpairpot, typename Ttabulator=Tabulate::Andrea<double> >
     class PotentialTabulate : public Tpairpot
     {
     private:
         Ttabulator tab;
+        Tabulate::Uniform<double> utab;
+        bool uniform; // use 'utab' instead of 'tab'
         typedef opair<int> Tpair;
         std::map<Tpair, typename Ttabulator::data> m;
 
     public:
         PotentialTabulate( Tmjson &j ) : Tpairpot(j)
         {
-            tab.setRange(
-                j["tab_rmin"] | 1.0,
-                j["tab_rmax"] | 100.0);
-            tab.setTolerance(
-                j["tab_utol"] | 0.01,
-                j["tab_ftol"] | -1.0,
-                j["tab_umaxtol"] | -1.0,
-                j["tab_fmaxtol"] | -1.0);
+            string tabtype = j.value("tab_type", string("default"));
+            if ( tabtype != "default" && tabtype != "uniform" )
+                throw std::runtime_error("PotentialTabulate: unknown tab_type '" + tabtype + "'");
+            uniform = (tabtype == "uniform");
+            auto setup = [&]( Tabulate::TabulatorBase<double> &t )
+            {
+                t.setRange(
+                    j["tab_rmin"] | 1.0,
+                    j["tab_rmax"] | 100.0);
+                t.setTolerance(
+                    j["tab_utol"] | 0.01,
+                    j["tab_ftol"] | -1.0,
+                    j["tab_umaxtol"] | -1.0,
+                    j["tab_fmaxtol"] | -1.0);
+            };
+            setup(tab);
+            setup(utab);
         }
 
         template<class Tparticle>
@@ -1286,13 +1650,129 @@ namespace Faunus
             Tpair ab(a.id, b.id);
             auto it = m.find(ab);
             if ( it != m.end())
-                return tab.eval(it->second, r2);
+                return uniform ? utab.eval(it->second, r2) : tab.eval(it->second, r2);
             std::function<double( double )> f = [=]( double r2 ) { return Tpairpot(*this)(a, b, r2); };
-            m[ab] = tab.generate_full(f);
+            m[ab] = uniform ? utab.generate_full(f) : tab.generate_full(f);
             return (*this)(a, b, r2);
         }
     };
 
+    /**
+     * @brief Tabulated energy and force of a pair potential for all atom type pairs
+     *
+     * On construction, the energy and force of `Tpairpot` are tabulated for
+     * every pair of atom types and stored in a dense type-pair matrix. This is
+     * intended for isotropic `CombinedPairPotential` chains where each term
+     * has its own `exp` or `pow`: evaluation is a single spline lookup no
+     * matter how many terms are summed. The force is tabulated from the
+     * numerical derivative of the summed energy and must therefore be
+     * continuous within the table range.
+     *
+     * If a pair has a cutoff, `PairPotentialBase::rcut2`, beyond which the
+     * energy is zero, the table ends at the cutoff and zero is returned
+     * beyond it without further evaluation. Otherwise, and below the table,
+     * the original potential is used.
+     *
+     * Keyword       | Description
+     * ------------- | -----------------------------------------------
+     * `tab_rmin`    | Lower table limit (default: 1 angstrom)
+     * `tab_rmax`    | Upper table limit if no cutoff (default: 100 angstrom)
+     * `tab_utol`    | Tolerance for energy and force (default: 0.01)
+     * `tab_umaxtol` | See `Tabulate::Andrea` (default: -1, off)
+     * `tab_cache`   | Binary file to store tables in, see `Tabulate::TableCache`
+     */
+    template<typename Tpairpot, typename Ttabulator=Tabulate::Andrea<double>, typename Tparticle=PointParticle>
+    class PotentialTabulateMatrix : public Tpairpot
+    {
+    private:
+        typedef typename Ttabulator::data Tdata;
+
+        struct Ttable
+        {
+            Tdata u, f;         // energy and force/r tables
+            double rmin2, rmax2; // table range
+            double rc2;          // zero energy beyond this
+        };
+
+        Ttabulator tab;
+        std::vector<Ttable> tables; // n x n type-pair matrix
+        size_t n;
+
+        /** @brief Squared cutoff of pair if the energy vanishes beyond it, otherwise infinity */
+        double cutoff2( const Tparticle &a, const Tparticle &b )
+        {
+            double rc2 = Tpairpot::rcut2(a.id, b.id);
+            if ( rc2 > 0 )
+                for ( double s : {1.0001, 1.1, 2.0, 10.0} )
+                    if ( Tpairpot::operator()(a, b, rc2 * s) != 0 )
+                        return pc::infty;
+            return (rc2 > 0) ? rc2 : pc::infty;
+        }
+
+    public:
+        PotentialTabulateMatrix( Tmjson &j ) : Tpairpot(j)
+        {
+            double rmin = j.value("tab_rmin", 1.0), rmax = j.value("tab_rmax", 100.0);
+            tab.setTolerance(
+                j.value("tab_utol", 0.01), -1,
+                j.value("tab_umaxtol", -1.0), -1);
+            Tabulate::TableCache<double> cache(j.value("tab_cache", string()));
+
+            n = atom.size();
+            tables.resize(n * n);
+            for ( size_t i = 0; i < n; i++ )
+                for ( size_t k = i; k < n; k++ )
+                {
+                    Tparticle a, b;
+                    a = atom[i];
+                    b = atom[k];
+                    Ttable t;
+                    t.rc2 = cutoff2(a, b);
+                    t.rmin2 = t.rmax2 = 0;
+                    if ( t.rc2 > rmin * rmin )
+                    {
+                        Tpairpot pot(*this);
+                        std::function<double( double )> u = [=]( double r2 ) mutable { return pot(a, b, r2); };
+                        double rc2 = t.rc2;
+                        std::function<double( double )> f = [=]( double r2 ) mutable {
+                            double h = 1e-6 * r2;
+                            double hi = std::min(r2 + h, rc2); // one-sided at the cutoff
+                            return -(pot(a, b, hi) - pot(a, b, hi - 2 * h)) / h;
+                        };
+                        tab.setRange(rmin, std::min(rmax, std::sqrt(t.rc2)));
+                        t.u = cache.generate(tab, u);
+                        t.f = cache.generate(tab, f);
+                        t.rmin2 = std::max(t.u.rmin2, t.f.rmin2);
+                        t.rmax2 = std::min(t.u.rmax2, t.f.rmax2);
+                    }
+                    tables[i * n + k] = tables[k * n + i] = t;
+                }
+            cache.save();
+        }
+
+        /** @brief Energy in kT between two particles, r2 = squared distance */
+        double operator()( const Tparticle &a, const Tparticle &b, double r2 )
+        {
+            const Ttable &t = tables[a.id * n + b.id];
+            if ( r2 >= t.rc2 )
+                return 0;
+            if ( r2 < t.rmax2 && r2 > t.rmin2 )
+                return tab.eval(t.u, r2);
+            return Tpairpot::operator()(a, b, r2);
+        }
+
+        /** @brief Force in kT/angstrom, cf. `PairPotentialBase::force()` */
+        Point force( const Tparticle &a, const Tparticle &b, double r2, const Point &p )
+        {
+            const Ttable &t = tables[a.id * n + b.id];
+            if ( r2 >= t.rc2 )
+                return Point(0, 0, 0);
+            if ( r2 < t.rmax2 && r2 > t.rmin2 )
+                return tab.eval(t.f, r2) * p;
+            return Tpairpot::force(a, b, r2, p);
+        }
+    };
+
     /**
      * @brief Construct a distance dependent potential from json entry
      *
@@ -1499,20 +1979,132 @@ namespace Faunus
      * If the pair is not recognized, i.e. not added with the
      * `add()` function, the `Tdefault` pair potential is used.
      * If the pair is found then a tabulation will be used.
+     *
+     * All tables are packed into a single arena where each interval
+     * occupies one cache line aligned block holding the lower knot
+     * followed by the polynomial coefficients. Tables are addressed
+     * through the dense type-pair index of `PotentialMap` so that an
+     * evaluation consists of a binary search in the knots of the pair
+     * and a Horner evaluation of a single block.
+     *
+     * If `tab_cache` is given, generated tables are stored in and
+     * loaded from this file, see `Tabulate::TableCache`.
      */
     template<typename Tdefault, typename Ttabulator=Tabulate::Andrea<double>, typename Tparticle=PointParticle>
     class PotentialMapTabulated : public PotentialMap<Tdefault>
     {
     private:
-        typedef opair<int> Tpair;
         typedef PotentialMap <Tdefault> base;
+        typedef typename Ttabulator::data Tdata;
+
+        struct Ttable
+        {
+            double rmin2, rmax2;
+            size_t knot;  // first knot in `knots`
+            size_t block; // first interval block in `arena`
+            size_t n;     // number of knots
+        };
+
         double rmin2, rmax2;
         int print;
         Ttabulator tab;
-        std::map<Tpair, typename Ttabulator::data> mtab;
+        Tabulate::TableCache<double> cache;
+        std::vector<Tdata> tables;  // generated tables; same order as base functors
+        std::vector<Ttable> packed; // location of each table in the arena
+        std::vector<double> knots;  // knots of all tables, ascending per table
+        std::vector<double> arena;  // interval blocks: lower knot + coefficients
+        size_t ncoeff = 0, stride = 1, offset = 0;
+        bool pending = false;       // tables added since the last `prepare()`
+
+        /** @brief Copy all tables into the contiguous arena */
+        void pack()
+        {
+            const size_t line = 64 / sizeof(double);
+            size_t nknots = 0, nblocks = 0;
+            for ( auto &d : tables )
+            {
+                nknots += d.r2.size();
+                if ( d.r2.size() > 1 )
+                {
+                    nblocks += d.r2.size() - 1;
+                    ncoeff = d.c.size() / (d.r2.size() - 1);
+                }
+            }
+            stride = 1;
+            while ( stride < ncoeff + 1 )
+                stride *= 2;
+
+            knots.clear();
+            knots.reserve(nknots);
+            arena.assign(nblocks * stride + line, 0);
+            offset = (64 - reinterpret_cast<size_t>(arena.data()) % 64) % 64 / sizeof(double);
+            packed.clear();
+
+            size_t block = 0;
+            for ( auto &d : tables )
+            {
+                Ttable t;
+                t.rmin2 = d.rmin2;
+                t.rmax2 = d.rmax2;
+                t.knot = knots.size();
+                t.block = block;
+                t.n = d.r2.size();
+                bool descending = (t.n > 1 && d.r2.front() > d.r2.back()); // e.g. AndreaIntel
+                for ( size_t i = 0; i < t.n; i++ )
+                    knots.push_back(descending ? d.r2[t.n - 1 - i] : d.r2[i]);
+                for ( size_t i = 0; i + 1 < t.n; i++ )
+                {
+                    size_t src = descending ? t.n - 2 - i : i;
+                    double *c = &arena[offset + (block + i) * stride];
+                    c[0] = knots[t.knot + i];
+                    for ( size_t j = 0; j < ncoeff; j++ )
+                        c[j + 1] = d.c[src * ncoeff + j];
+                }
+                if ( t.n > 1 )
+                    block += t.n - 1;
+                packed.push_back(t);
+            }
+        }
+
+        static double horner( const double *c, double, std::integral_constant<int, 1> ) { return c[0]; }
+
+        template<int K>
+        static double horner( const double *c, double dz, std::integral_constant<int, K> )
+        {
+            return c[0] + dz * horner(c + 1, dz, std::integral_constant<int, K - 1>());
+        }
+
+        /** @brief Evaluate packed table at r2 which must be within the knots */
+        double eval( const Ttable &t, double r2 ) const
+        {
+            const double *k = knots.data() + t.knot, *low = k;
+            size_t len = t.n;
+            while ( len > 1 )
+            { // branch-free lower bound
+                size_t half = len / 2;
+                low = (low[half] < r2) ? low + half : low;
+                len -= half;
+            }
+            size_t pos = (low - k) + (*low < r2) - 1;
+            const double *c = arena.data() + offset + (t.block + pos) * stride;
+            double dz = r2 - c[0];
+            switch ( ncoeff )
+            { // unrolled for the in-tree tabulators
+                case 6:
+                    return horner(c + 1, dz, std::integral_constant<int, 6>());
+                case 4:
+                    return horner(c + 1, dz, std::integral_constant<int, 4>());
+                case 2:
+                    return horner(c + 1, dz, std::integral_constant<int, 2>());
+            }
+            double u = c[ncoeff];
+            for ( size_t j = ncoeff - 1; j > 0; j-- )
+                u = c[j] + dz * u;
+            return u;
+        }
 
     public:
-        PotentialMapTabulated( InputMap &in ) : base(in)
+        PotentialMapTabulated( InputMap &in ) : base(in), cache(in.get<std::string>("tab_cache", ""))
         {
             rmin2 = in.get<double>("tab_rmin", 1.0);
             rmax2 = in.get<double>("tab_rmax", 100.0);
@@ -1531,14 +2123,17 @@ namespace Faunus
 
         double operator()( const Tparticle &a, const Tparticle &b, double r2 )
         {
-            auto ab = Tpair(a.id, b.id);
-            auto it = mtab.find(ab);
-            if ( it != mtab.end())
+            int k = base::lookup(a.id, b.id);
+            if ( k != 0 )
             {
-                if ( r2 < it->second.rmax2 )
-                    if ( r2 > it->second.rmin2 )
-                        return tab.eval(it->second, r2);
-                return base::m[ab](a, b, r2); // fall back to original
+                if ( !pending )
+                {
+                    const Ttable &t = packed[k - 1];
+                    if ( r2 < t.rmax2 )
+                        if ( r2 > t.rmin2 )
+                            return eval(t, r2);
+                }
+                return base::operator()(a, b, r2); // fall back to original
             }
             return Tdefault::operator()(a, b, r2); // fall back to default
         }
@@ -1551,24 +2146,51 @@ namespace Faunus
             b = atom[id2];
             base::add(a.id, b.id, pot);
             std::function<double( double )> f = [=]( double r2 ) { return Tpairpot(pot)(a, b, r2); };
-            mtab[Tpair(id1, id2)] = tab.generate(f);
+            size_t k = base::lookup(id1, id2);
+            if ( tables.size() < k )
+                tables.resize(k);
+            tables[k - 1] = cache.generate(tab, f);
+            pending = true;
+        }
+
+        /**
+         * @brief Pack the added tables and write the table cache
+         *
+         * Called once all pairs have been added; `setSpace()` does this
+         * automatically. Until then pairs fall back to the original potential.
+         */
+        void prepare()
+        {
+            if ( pending )
+            {
+                pack();
+                cache.save();
+                pending = false;
+            }
+        }
+
+        template<class Tspace>
+        void setSpace( Tspace &s )
+        {
+            base::setSpace(s);
+            prepare();
         }
 
         std::string info( char w = 20 )
         {
             using namespace Faunus::textio;
+            prepare();
             std::ostringstream o(base::info(w));
             o << tab.info(w) << std::endl;
-            for ( auto &i : mtab )
-            {
-                auto ab = Tpair(i.first.first, i.first.second);
-                auto it = mtab.find(ab);
-                o << pad(SUB,
-                         w,
-                         "Nbr of elements in table (" + atom[i.first.first].name + "<->" + atom[i.first.second].name
-                             + "): ")
-                  << it->second.r2.size() << endl;
-            }
+            for ( size_t i = 0; i < atom.size(); i++ )
+                for ( size_t j = i; j < atom.size(); j++ )
+                {
+                    int k = base::lookup(i, j);
+                    if ( k != 0 )
+                        o << pad(SUB, w, "Nbr of elements in table (" + atom[i].name + "<->" + atom[j].name + "): ")
+                          << packed[k - 1].n << endl;
+                }
+            o << pad(SUB, w, "Table arena size") << arena.size() * sizeof(double) / 1024. << " kb" << endl;
             o << endl;
             if ( print == 1 )
                 print_tabulation();
@@ -1577,33 +2199,35 @@ namespace Faunus
 
         void print_tabulation( int n = 1000 )
         {
-            for ( auto &i : mtab )
-            {
-                auto ab = Tpair(i.first.first, i.first.second);
-                auto it = mtab.find(ab);
+            prepare();
+            for ( size_t i = 0; i < atom.size(); i++ )
+                for ( size_t j = i; j < atom.size(); j++ )
+                {
+                    int k = base::lookup(i, j);
+                    if ( k == 0 )
+                        continue;
+                    const Ttable &t = packed[k - 1];
 
-                Tparticle a, b;
-                a = atom[i.first.first];
-                b = atom[i.first.second];
+                    Tparticle a, b;
+                    a = atom[i];
+                    b = atom[j];
 
-                std::ofstream
-                    ff1(std::string(atom[i.first.first].name + "." + atom[i.first.second].name + ".real.dat").c_str());
-                ff1.precision(10);
+                    std::ofstream ff1(std::string(atom[i].name + "." + atom[j].name + ".real.dat").c_str());
+                    ff1.precision(10);
 
-                std::ofstream
-                    ff2(std::string(atom[i.first.first].name + "." + atom[i.first.second].name + ".tab.dat").c_str());
-                ff2.precision(10);
+                    std::ofstream ff2(std::string(atom[i].name + "." + atom[j].name + ".tab.dat").c_str());
+                    ff2.precision(10);
 
-                double max = it->second.r2.at(it->second.r2.size() - 2);
-                double min = it->second.rmin2;
-                double dr = (max - min) / (double) n;
-                for ( int j = 1; j < n; j++ )
-                {
-                    double r2 = min + dr * ((double) j);
-                    ff1 << sqrt(r2) << " " << base::m[ab](a, b, r2) << endl;
-                    ff2 << sqrt(r2) << " " << tab.eval(it->second, r2) << endl;
+                    double max = knots.at(t.knot + t.n - 2);
+                    double min = t.rmin2;
+                    double dr = (max - min) / (double) n;
+                    for ( int l = 1; l < n; l++ )
+                    {
+                        double r2 = min + dr * ((double) l);
+                        ff1 << sqrt(r2) << " " << base::operator()(a, b, r2) << endl;
+                        ff2 << sqrt(r2) << " " << eval(t, r2) << endl;
+                    }
                 }
-            }
         }
     };
 
@@ -390,6 +390,8 @@ namespace Faunus
 
         auto tuple() -> decltype(std::make_tuple(this)) { return std::make_tuple(this); }
 
+        double cutoff() const override { return 0; }
+
         template<class Tpvec>
         int findSites( const Tpvec &p )
         {
@@ -4,6 +4,10 @@
 #include <catch/catch.hpp>
 #include <faunus/faunus.h>
 #include <faunus/ewald.h>
+#include <faunus/celllist.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace Faunus;
 
@@ -31,12 +35,61 @@ void checkTabulator(Ttabulator t) {
   }
 }
 
+/* check packed tabulation in potential map against the tabulator itself */
+template<typename Ttabulator>
+void checkMapTabulator(Ttabulator t) {
+  InputMap in("unittests.json");
+  in["tab_rmin"] = 2.0;
+  in["tab_rmax"] = 20.0;
+  Tmjson js = { {"epsr", 2.0} };
+  Potential::PotentialMapTabulated<Potential::Coulomb,Ttabulator> pot(in);
+  Potential::Coulomb coulomb(js);
+  int sol=0, MM=1; // any two atom types; the charge is set here and restored below
+  double q=atom[sol].charge;
+  atom[sol].charge=1.0;
+  pot.add( MM, MM, Potential::Coulomb(js) );
+  pot.add( sol, sol, coulomb );
+  pot.prepare();
+
+  PointParticle a, b;
+  a = b = atom[sol]; // tables use charges from the atom list
+  t.setRange(2.0, 20.0);
+  auto data = t.generate( [&](double r2) { return coulomb(a,b,r2); } );
+
+  for (double r=2.5; r<19.5; r+=0.5) {
+    CHECK( pot(a,b,r*r) == Approx(t.eval(data,r*r)) );
+    CHECK( fabs(pot(a,b,r*r) - coulomb(a,b,r*r)) < 0.01 );
+  }
+  CHECK( pot(a,b,1.0) == Approx(coulomb(a,b,1.0)) ); // outside table
+  b.id = MM;
+  CHECK( pot(a,b,9.0) == Approx(pot.Potential::Coulomb::operator()(a,b,9.0)) ); // default
+  atom[sol].charge=q;
+}
+
+/* short ranged test potential with a cutoff reported through rcut2 */
+struct CutPotential : public Potential::PairPotentialBase {
+  CutPotential(Tmjson &j) {
+    for (size_t i=0; i<atom.size(); i++)
+      for (size_t k=0; k<atom.size(); k++)
+        rcut2.set(i,k,100);
+  }
+  template<class Tparticle>
+    double operator()(const Tparticle &a, const Tparticle &b, double r2) const {
+      return (r2<100) ? std::pow(1-r2/100, 3) : 0;
+    }
+  template<class Tparticle>
+    Point force(const Tparticle &a, const Tparticle &b, double r2, const Point &p) const {
+      return (r2<100) ? 0.06*std::pow(1-r2/100, 2)*p : Point(0,0,0);
+    }
+};
+
 TEST_CASE("Spline table", "Spline")
 {
   checkTabulator(Tabulate::Hermite<double>());
   checkTabulator(Tabulate::AndreaIntel<double>());
   checkTabulator(Tabulate::Andrea<double>());
   checkTabulator(Tabulate::Linear<double>());
+  checkTabulator(Tabulate::Uniform<double>());
 
   PointParticle a,b;
   a.charge=1;
@@ -54,9 +107,86 @@ TEST_CASE("Spline table", "Spline")
   CHECK(error>0);
   CHECK(error<0.01);
 
+  // Uniform grid tabulation selected through json
+  js["tab_type"] = "uniform";
+  Potential::PotentialTabulate<Potential::Coulomb> pot_uni( js );
+  for (double r=1.5; r<50; r+=2.5)
+    CHECK( fabs( pot_org(a,b,r*r)-pot_uni(a,b,r*r) ) < 0.01 );
+  Tmjson jg = { {"coulombtype","wolf"}, {"cutoff",12.0}, {"epsr",80.0}, {"alpha",0.2} };
+  Potential::CoulombGalore galore( jg );
+  jg["tab_type"] = "uniform";
+  Potential::CoulombGalore galore_uni( jg );
+  for (double r=1.0; r<12; r+=0.7)
+    CHECK( galore_uni(a,b,r*r) == Approx(galore(a,b,r*r)).epsilon(1e-6) );
+
+  // Table cache: tables are loaded from disk unless function or settings change
+  {
+    std::string file = "unittests_tabcache.bin";
+    std::remove(file.c_str());
+    Tabulate::Andrea<double> t;
+    t.setRange(0.9, 100);
+    std::function<double(double)> f = [](double x) { return 1/x; };
+    Tabulate::TableCache<double> cache(file);
+    auto d1 = cache.generate(t, f);
+    cache.save();
+    Tabulate::TableCache<double> cache2(file);
+    CHECK( cache2.size() == 1 );
+    auto d2 = cache2.generate(t, f);
+    CHECK( d2.r2 == d1.r2 );
+    CHECK( d2.c == d1.c );
+    t.setTolerance(0.001);
+    cache2.generate(t, f);
+    CHECK( cache2.size() == 2 );
+    // differs from `f` only below r=1.2; must not be served from the cache
+    std::function<double(double)> g = [](double x) { return x<1.44 ? 1/x + 2*(1.44-x) : 1/x; };
+    auto d3 = cache2.generate(t, g);
+    CHECK( cache2.size() == 3 );
+    CHECK( t.eval(d3, 1.0) == Approx(g(1.0)).epsilon(0.01) );
+
+    jg["tab_cache"] = file;
+    Potential::CoulombGalore galore_c1( jg ), galore_c2( jg );
+    CHECK( Tabulate::TableCache<double>(file).size() == 2 );
+    CHECK( galore_c2(a,b,25.0) == Approx(galore_uni(a,b,25.0)) );
+    std::remove(file.c_str());
+  }
+
   // Check if negative potential operator works
   auto minus = Potential::Coulomb( js ) - Potential::Coulomb( js );
   CHECK( abs(minus(a,b,7)) < 1e-6 );
+
+  checkMapTabulator(Tabulate::Andrea<double>());
+  checkMapTabulator(Tabulate::AndreaIntel<double>());
+  checkMapTabulator(Tabulate::Hermite<double>());
+
+  // Combined potential tabulated for all type pairs
+  {
+    double q0=atom[0].charge, q1=atom[1].charge;
+    atom[0].charge=1.0;
+    atom[1].charge=-1.0;
+    Tmjson jc = { {"epsr",80.0}, {"debyelength",10.0}, {"cutoff",10.0}, {"tab_utol",1e-5} };
+    typedef Potential::CombinedPairPotential<Potential::DebyeHuckelShift,CutPotential> Tpair;
+    Tpair ref(jc);
+    Potential::PotentialTabulateMatrix<Tpair> pot(jc);
+    PointParticle a, b;
+    a = atom[0];
+    b = atom[1];
+    Point p(0,0,1);
+    for (double r=1.5; r<9.9; r+=0.4) {
+      CHECK( fabs( pot(a,b,r*r)-ref(a,b,r*r) ) < 1e-5 );
+      CHECK( fabs( pot.force(a,b,r*r,p).z()-ref.force(a,b,r*r,p).z() ) < 1e-4 );
+    }
+    CHECK( pot(a,b,0.5) == Approx(ref(a,b,0.5)) ); // below table
+    CHECK( pot(a,b,150.0) == 0 ); // beyond cutoff
+
+    // energy does not vanish beyond rcut2 so the cutoff must be ignored
+    typedef Potential::CombinedPairPotential<Potential::DebyeHuckel,CutPotential> Tpair2;
+    Tpair2 ref2(jc);
+    Potential::PotentialTabulateMatrix<Tpair2> pot2(jc);
+    CHECK( pot2(a,b,150.0) == Approx(ref2(a,b,150.0)) );
+    CHECK( pot2(a,b,150.0) < 0 );
+    atom[0].charge=q0;
+    atom[1].charge=q1;
+  }
 }
 
 /*
@@ -138,6 +268,7 @@ TEST_CASE("Ewald Test","Ion-Ion- and Dipole-Dipole-interaction")
   spc.p.resize(4);
   Group g(0,3);
   spc.groupList().push_back(&g);
+  spc.updateGroupIndex();
   
   spc.p[0] = Point(0,0,0);
   spc.p[1] = Point(1,0,0);
@@ -190,6 +321,880 @@ TEST_CASE("Ewald Test","Ion-Ion- and Dipole-Dipole-interaction")
   CHECK(usurf_reci == Approx(0.582251578315622*lB)); // reciprocal energy in addition to surface energy
   CHECK(uself == Approx(-0.538268271364301*lB));
   CHECK(Energy::systemEnergy(spc,pot,spc.p) == Approx(-2.0003749*lB));  // Total dipole-dipole interaction energy
+
+  // Incremental update for a whole-group move must match a full recalculation
+  spc.p[0].charge = 1.0;
+  spc.p[1].charge = -1.0;
+  spc.trial = spc.p;
+  pot.setSpace(spc);
+  usurf_reci = pot.external(spc.p);
+  for (auto i : g)
+    spc.trial[i] += Point(0.3,-0.2,0.1);
+  Tspace::Change cg;
+  cg.mvGroup[0]; // empty particle list = entire group moved
+  pot.updateChange(cg);
+  double usurf_reci_trial = pot.external(spc.trial);
+  pot.update(false); // reject
+  CHECK(pot.external(spc.p) == Approx(usurf_reci));
+  pot.updateChange(cg);
+  pot.update(true); // accept
+  spc.p = spc.trial;
+  auto pot2 = Energy::NonbondedEwald<Tspace,Potential::HardSphere,true,false,true>(in);
+  pot2.setSpace(spc);
+  CHECK(usurf_reci_trial == Approx(pot2.external(spc.p)));
+  CHECK(pot.external(spc.p) == Approx(pot2.external(spc.p)));
+
+  // Auto-tuned parameters must reproduce the total energy
+  for (auto i : g) {
+    spc.p[i] = Point(slump()-0.5, slump()-0.5, slump()-0.5) * 10.0;
+    spc.p[i].charge = (i % 2) ? 1.0 : -1.0;
+    spc.p[i].muscalar() = 0.0;
+  }
+  spc.trial = spc.p;
+  in["energy"]["nonbonded"]["ewald"]["autotune"] = true;
+  in["energy"]["nonbonded"]["ewald"]["delta"] = 1e-7;
+  auto pot3 = Energy::NonbondedEwald<Tspace,Potential::HardSphere,true,false,true>(in);
+  pot2.setSpace(spc);
+  pot3.setSpace(spc);
+  auto j = static_cast<Energy::Energybase<Tspace>&>(pot3).json()["ewald"]; // as reported by Hamiltonians
+  CHECK(j.count("time real/us") == 1);
+  CHECK(double(j["alpha"]) > 0);
+  CHECK(Energy::systemEnergy(spc,pot3,spc.p) == Approx(Energy::systemEnergy(spc,pot2,spc.p)).epsilon(1e-4));
+}
+
+TEST_CASE("Particle-mesh Ewald", "Compare SPME with Ewald summation and check incremental updates")
+{
+  RandomTwister<> ran; // own generator so that the configuration is independent of test order
+
+  // mixed-radix FFT against a plain DFT
+  for (int n : {1, 7, 12, 25, 32, 49, 50}) {
+    FFT fft(n);
+    vector<std::complex<double>> x(n), X(n);
+    for (int j=0; j<n; j++)
+      x[j] = std::complex<double>(ran()-0.5, ran()-0.5);
+    fft.forward(x.data(), X.data());
+    for (int k=0; k<n; k++) {
+      std::complex<double> s(0,0);
+      for (int j=0; j<n; j++)
+        s += x[j] * std::polar(1.0, -2*pc::pi*j*k/n);
+      CHECK(std::abs(X[k]-s) < 1e-10);
+    }
+  }
+
+  typedef Space<Geometry::Cuboid,PointParticle> Tspace;
+  typedef Energy::NonbondedSPME<Tspace,Potential::HardSphere> Tspme;
+  InputMap in("unittests.json");
+  in["energy"]["nonbonded"]["spme"] = in["energy"]["nonbonded"]["ewald"];
+  in["energy"]["nonbonded"]["spme"]["order"] = 6;
+  Tspace spc(in);
+  spc.p.resize(40);
+  Group g(0,39);
+  spc.groupList().push_back(&g);
+  spc.updateGroupIndex();
+  Point L = spc.geo.len;
+  for (auto i : g) { // distorted 4x5x2 lattice of alternating charges
+    Point u( (i%4+0.5)/4 + 0.05*(ran()-0.5), (i/4%5+0.5)/5 + 0.05*(ran()-0.5), (i/20+0.5)/2 + 0.05*(ran()-0.5) );
+    spc.p[i] = (u - Point(0.5,0.5,0.5)).cwiseProduct(L);
+    spc.p[i].charge = ((i%4 + i/4%5 + i/20) % 2) ? 1.0 : -1.0;
+  }
+  spc.trial = spc.p;
+
+  auto ewald = Energy::NonbondedEwald<Tspace,Potential::HardSphere>(in);
+  Tspme pot(in);
+  ewald.setSpace(spc);
+  pot.setSpace(spc);
+  CHECK(pot.external(spc.p) == Approx(ewald.external(spc.p)).epsilon(1e-5));
+  CHECK(Energy::systemEnergy(spc,pot,spc.p) == Approx(Energy::systemEnergy(spc,ewald,spc.p)).epsilon(1e-5));
+
+  // local moves (accepted and rejected) and a whole group move against a rebuilt grid
+  for (int n=0; n<10; n++) {
+    Tspace::Change c;
+    if (n < 9) {
+      int i = ran() * spc.p.size();
+      spc.trial[i].translate(spc.geo, Point(ran()-0.5, ran()-0.5, ran()-0.5));
+      c.mvGroup[0].push_back(i);
+    } else {
+      for (auto i : g)
+        spc.trial[i].translate(spc.geo, Point(0.3, -0.2, 0.1));
+      c.mvGroup[0]; // entire group
+    }
+    pot.updateChange(c);
+    double utrial = pot.external(spc.trial);
+    bool accept = (n % 3 != 1);
+    if (accept)
+      spc.p = spc.trial;
+    else
+      spc.trial = spc.p;
+    pot.update(accept);
+    Tspme ref(in);
+    ref.setSpace(spc);
+    if (accept)
+      CHECK(utrial == Approx(ref.external(spc.p)));
+    CHECK(pot.external(spc.p) == Approx(ref.external(spc.p)));
+  }
+}
+
+/*
+ * Compare short ranged nonbonded energy class against plain N^2 loops,
+ * before and after a series of accepted and rejected particle moves
+ */
+template<class Tgeometry, template<class,class> class Tenergy>
+void testNeighbourEnergy()
+{
+  typedef Space<Tgeometry,PointParticle> Tspace;
+  typedef Potential::CutShift<Potential::Coulomb,false> Tpairpot;
+  InputMap in("unittests.json");
+  in["energy"]["nonbonded"]["cutoff"] = 2.5;
+  in["system"]["geometry"]["radius"] = 6.0;
+  Tspace spc(in);
+  spc.p.resize(200);
+  for (size_t i=0; i<spc.p.size(); i++) {
+    spc.geo.randompos( spc.p[i] );
+    spc.p[i].charge = (i%2==0) ? 1 : -1;
+  }
+  spc.trial = spc.p;
+  Group g(0,199), g1(0,99), g2(100,199);
+  spc.groupList().push_back(&g);
+  spc.updateGroupIndex();
+
+  Energy::Nonbonded<Tspace,Tpairpot> pot(in);
+  Tenergy<Tspace,Tpairpot> potnb(in);
+  pot.setSpace(spc);
+  potnb.setSpace(spc);
+
+  auto compare = [&](typename Tspace::ParticleVector &p) {
+    for (int i : {0, 17, 101, 199})
+      CHECK( potnb.i2all(p,i) == Approx(pot.i2all(p,i)) );
+    CHECK( potnb.i2g(p,g2,5) == Approx(pot.i2g(p,g2,5)) );
+    CHECK( potnb.g2g(p,g1,g2) == Approx(pot.g2g(p,g1,g2)) );
+    CHECK( potnb.g2g(p,g,g2) == Approx(pot.g2g(p,g,g2)) );
+    CHECK( potnb.g_internal(p,g) == Approx(pot.g_internal(p,g)) );
+  };
+  compare(spc.p);
+
+  // displace particles and check that trial and accepted states follow
+  for (int n=0; n<50; n++) {
+    int i = g.random();
+    spc.trial[i].translate( spc.geo, Point(slump.half(),slump.half(),slump.half())*4 );
+    typename Tspace::Change c;
+    c.mvGroup[0].push_back(i);
+    potnb.updateChange(c);
+    compare(spc.trial);
+    bool accept = (n%3 != 0);
+    if (accept)
+      spc.p[i] = spc.trial[i];
+    else
+      spc.trial[i] = spc.p[i];
+    potnb.update(accept);
+  }
+  compare(spc.p);
+  spc.groupList().clear();
+}
+
+TEST_CASE("Cell list", "Compare cell list energies with plain N^2 loops")
+{
+  testNeighbourEnergy<Geometry::Cuboid, Energy::NonbondedCellList>();
+  testNeighbourEnergy<Geometry::Sphere, Energy::NonbondedCellList>();
+  testNeighbourEnergy<Geometry::PeriodicCylinder, Energy::NonbondedCellList>();
+}
+
+TEST_CASE("Verlet list", "Compare Verlet list energies with plain N^2 loops")
+{
+  testNeighbourEnergy<Geometry::Cuboid, Energy::NonbondedVerlet>();
+  testNeighbourEnergy<Geometry::Sphere, Energy::NonbondedVerlet>();
+}
+
+/*
+ * Compare neighbours found by a synchronised cell list with a direct
+ * search while particles are displaced and the box is rescaled
+ */
+template<class Tgeometry>
+void testSyncedCellList()
+{
+  typedef Space<Tgeometry,PointParticle> Tspace;
+  InputMap in("unittests.json");
+  in["system"]["geometry"]["length"] = 30.0;
+  in["system"]["geometry"]["radius"] = 15.0;
+  Tspace spc(in);
+  spc.p.resize(300);
+  for (auto &a : spc.p)
+    spc.geo.randompos(a);
+  Group g(100,249);
+  Geometry::SyncedCellList<Tgeometry> cl;
+  std::vector<int> log;
+  unsigned int epoch = 0;
+  double rc = 4.0;
+  for (int n=0; n<10; n++) {
+    for (int k=0; k<20; k++) { // other moves may change any particle
+      int i = slump()*spc.p.size();
+      spc.geo.randompos( spc.p[i] );
+      log.push_back(i);
+    }
+    if (n==5)
+      spc.geo.setVolume( 1.2*spc.geo.getVolume() );
+    if (n==7) { // unknown change
+      for (auto &a : spc.p)
+        spc.geo.randompos(a);
+      log.clear();
+      epoch++;
+    }
+    cl.sync(spc.geo.inscribe().len, rc, spc.p, g, log, epoch);
+    int foreign = 0, missing = 0;
+    for (auto &a : spc.p) {
+      std::set<int> found;
+      cl.forEachNeighbour(a, [&](int j) { found.insert(j); });
+      for (auto j : found)
+        foreign += !g.find(j);
+      for (auto j : g)
+        if ( spc.geo.sqdist(a, spc.p[j]) < rc*rc )
+          missing += (found.count(j)==0);
+    }
+    CHECK( foreign == 0 );
+    CHECK( missing == 0 );
+  }
+}
+
+TEST_CASE("Synced cell list", "Compare neighbours from synchronised cell list with direct search")
+{
+  testSyncedCellList<Geometry::Cuboid>();
+  testSyncedCellList<Geometry::Sphere>();
+}
+
+TEST_CASE("Batched pair potential", "Compare batched and scalar nonbonded energies")
+{
+  typedef Space<Geometry::Cuboid,PointParticle> Tspace;
+  typedef Potential::CombinedPairPotential<Potential::CoulombGalore,Potential::LennardJonesLB> Tpairpot;
+  InputMap in("unittests.json");
+  in["energy"]["nonbonded"]["coulombtype"] = "plain";
+  in["energy"]["nonbonded"]["cutoff"] = 4.0;
+  in["energy"]["nonbonded"]["ljcustom"]["Na MM"] = { {"sigma",3.0}, {"eps",0.5} };
+  Tspace spc(in);
+  spc.p.resize(100);
+  for (size_t i=0; i<spc.p.size(); i++) {
+    spc.geo.randompos( spc.p[i] );
+    spc.p[i].id = i%3;
+    spc.p[i].charge = (i%2==0) ? 1 : -1;
+  }
+  spc.trial = spc.p;
+  Group g(0,99), g1(10,49);
+  spc.groupList().push_back(&g);
+  spc.updateGroupIndex();
+
+  Energy::Nonbonded<Tspace,Tpairpot> pot(in);
+  in["energy"]["nonbonded"]["batch"] = true;
+  Energy::Nonbonded<Tspace,Tpairpot> potb(in);
+  pot.setSpace(spc);
+  potb.setSpace(spc);
+
+  CHECK( (Energy::HasBatch<Tpairpot,PointParticle>::value) );
+  CHECK_FALSE( (Energy::HasBatch<Potential::CombinedPairPotential<Potential::CoulombGalore,Potential::HardSphere>,PointParticle>::value) );
+
+  spc.trial[20].translate( spc.geo, Point(1,1,1) );
+  Tspace::Change c;
+  c.mvGroup[0] = {20};
+  spc.syncArrays(c);
+  for (auto *p : {&spc.p, &spc.trial})
+    for (int i : {0, 20, 99}) {
+      CHECK( potb.i2all(*p,i) == Approx(pot.i2all(*p,i)) );
+      CHECK( potb.i2g(*p,g1,i) == Approx(pot.i2g(*p,g1,i)) );
+    }
+  spc.groupList().clear();
+}
+
+TEST_CASE("Static Hamiltonian", "Compare compile-time composed energy with operator+ composition")
+{
+  typedef Space<Geometry::Cuboid,PointParticle> Tspace;
+  typedef Potential::PairPotentialSum<Potential::CoulombGalore,Potential::LennardJonesLB>::type Tpairpot;
+  typedef Energy::Nonbonded<Tspace,Tpairpot> Tnonbonded;
+  InputMap in("unittests.json");
+  in["energy"]["nonbonded"]["coulombtype"] = "plain";
+  in["energy"]["nonbonded"]["cutoff"] = 4.0;
+  in["moves"]["isobaric"]["pressure"] = 10.0;
+  Tspace spc(in);
+  spc.p.resize(60);
+  for (size_t i=0; i<spc.p.size(); i++) {
+    spc.geo.randompos( spc.p[i] );
+    spc.p[i].id = i%3;
+    spc.p[i].charge = (i%2==0) ? 1 : -1;
+  }
+  spc.trial = spc.p;
+  Group g1(0,29), g2(30,59);
+  g1.molId = g2.molId = 0;
+  spc.groupList().push_back(&g1);
+  spc.groupList().push_back(&g2);
+  spc.updateGroupIndex();
+
+  auto pot = Tnonbonded(in) + Energy::ExternalPressure<Tspace>(in);
+  Energy::StaticHamiltonian<Tspace, Tnonbonded, Energy::ExternalPressure<Tspace>> spot(in);
+  pot.setSpace(spc);
+  spot.setSpace(spc);
+
+  auto t = spot.tuple();
+  CHECK( std::get<0>(t) == &spot.first );
+  CHECK( TupleFindType::get<Energy::ExternalPressure<Tspace>*>(t) != nullptr );
+  CHECK( spot.systemEnergy(spc.p) == Approx(pot.systemEnergy(spc.p)) );
+  CHECK( spot.g2g(spc.p,g1,g2) == Approx(pot.g2g(spc.p,g1,g2)) );
+  CHECK( spot.g_external(spc.p,g1) == Approx(pot.g_external(spc.p,g1)) );
+  CHECK( spot.external(spc.p) == Approx(pot.external(spc.p)) );
+  for (int i : {0, 31})
+    CHECK( spot.i2all(spc.p,i) == Approx(pot.i2all(spc.p,i)) );
+  spc.groupList().clear();
+}
+
+TEST_CASE("Potential map", "Check custom pair potentials between specific particle types")
+{
+  InputMap in("unittests.json");
+  atom.include( in["atomlist"] );
+  Potential::PotentialMap<Potential::Coulomb> pot( in["energy"]["nonbonded"] );
+  Potential::Coulomb coulomb( in["energy"]["nonbonded"] );
+  int Na=atom["Na"].id, Cl=atom["Cl"].id, MM=atom["MM"].id;
+  pot.add( Na, MM, Potential::HardSphere(in) );
+
+  PointParticle a, b;
+  a.charge = b.charge = 1;
+  a.radius = b.radius = 1;
+  CHECK( pot.lookup(Na,MM) == pot.lookup(MM,Na) );
+  CHECK( pot.lookup(Na,Cl) == 0 );
+  CHECK( pot.lookup(Na,AtomData::Tid(atom.size())) == 0 ); // out of range
+  a.id=Na; b.id=MM;
+  CHECK( pot(a,b,9.0) == Approx(0) );
+  CHECK( pot(b,a,9.0) == Approx(0) );
+  CHECK( pot(a,b,1.0) == pc::infty );
+  b.id=Cl;
+  CHECK( pot(a,b,9.0) == Approx(coulomb(a,b,9.0)) );
+  CHECK( pot(a,b,9.0) != Approx(0) );
+}
+
+TEST_CASE("Energy change", "Compare atom resolved energy change with system energy difference")
+{
+  typedef Space<Geometry::Cuboid,PointParticle> Tspace;
+  InputMap in("unittests.json");
+  in["energy"]["nonbonded"]["cutoff"] = 4.0;
+  Tspace spc(in);
+  spc.p.resize(200);
+  for (size_t i=0; i<spc.p.size(); i++) {
+    spc.geo.randompos( spc.p[i] );
+    spc.p[i].charge = (i%2==0) ? 1 : -1;
+  }
+  spc.trial = spc.p;
+  Group salt1(0,99), salt2(100,149), mol(150,199);
+  salt1.setMolSize(1);
+  salt2.setMolSize(1);
+  mol.setMolSize(50);
+  spc.groupList() = {&salt1, &salt2, &mol};
+  spc.updateGroupIndex();
+
+  Energy::Nonbonded<Tspace,Potential::CutShift<Potential::Coulomb,false>> pot(in);
+  pot.setSpace(spc);
+
+  auto check = [&](Tspace::Change &c) {
+    for (auto &m : c.mvGroup)
+      if (m.second.empty())
+        for (auto i : *spc.groupList()[m.first])
+          spc.trial[i].translate( spc.geo, Point(1,0,0) );
+      else
+        for (auto i : m.second)
+          spc.trial[i].translate( spc.geo, Point(slump.half(),slump.half(),slump.half()) );
+    double du = Energy::systemEnergy(spc,pot,spc.trial) - Energy::systemEnergy(spc,pot,spc.p);
+    CHECK( Energy::energyChange(spc,pot,c) == Approx(du) );
+    spc.trial = spc.p;
+  };
+
+  Tspace::Change c;
+  c.mvGroup[0] = {3, 7, 60};
+  check(c);         // atoms within one atomic group
+  c.mvGroup[1] = {120};
+  check(c);         // atoms in two atomic groups
+  c.mvGroup[2].clear();
+  check(c);         // ...and a whole molecule
+
+#ifdef _OPENMP
+  // group pair sums must not depend on the number of threads
+  int nt = omp_get_max_threads();
+  c.mvGroup.erase(2);
+  omp_set_num_threads(1);
+  double u = pot.systemEnergy(spc.p), du = pot.g2All(spc.p, c.mvGroup);
+  omp_set_num_threads(4);
+  CHECK( pot.systemEnergy(spc.p) == u );
+  CHECK( pot.g2All(spc.p, c.mvGroup) == du );
+  omp_set_num_threads(nt);
+#endif
+  spc.groupList().clear();
+}
+
+TEST_CASE("Volume scaling", "Compare power law volume scaling with full energy recalculation")
+{
+  typedef Space<Geometry::Cuboid,PointParticle> Tspace;
+  typedef Energy::Nonbonded<Tspace,Potential::CoulombLJ> Tnonbonded;
+  InputMap in("unittests.json");
+  in["energy"]["nonbonded"]["powerlaw"] = true;
+  in["energy"]["nonbonded"]["eps"] = 0.2;
+  in["moves"]["isobaric"]["pressure"] = 10.0;
+  in["system"]["geometry"]["length"] = 40.0;
+  Tspace spc(in);
+  auto m = spc.molList().find("salt");
+  for (int i=0; i<50; i++)
+    spc.insert( m->id, m->getRandomConformation() );
+  for (size_t i=0; i<spc.p.size(); i++) { // 5x5x4 lattice
+    spc.p[i] = Point(i%5, (i/5)%5, i/25) * 8.0 - Point(16,16,12);
+    spc.p[i].charge = (i%2==0) ? 1 : -1;
+    spc.p[i].radius = 1.5;
+  }
+  spc.trial = spc.p;
+
+  auto pot = Tnonbonded(in) + Energy::ExternalPressure<Tspace>(in);
+  pot.setSpace(spc);
+  CHECK( Potential::PowerLaw<Potential::CoulombLJ>::value );
+  CHECK( !Potential::PowerLaw<Potential::CoulombLJTS>::value );
+
+  // single scaling compared with systemEnergy() at the old and new volume
+  double V = spc.geo.getVolume(), s = std::cbrt(1.1), du;
+  spc.geo_trial = spc.geo;
+  spc.geo_trial.setVolume(1.1*V);
+  CHECK( pot.scaledEnergyChange(s, du) );
+  double uold = pot.systemEnergy(spc.p);
+  for (auto &a : spc.trial)
+    a = a * s;
+  spc.geo = spc.geo_trial;
+  pot.setSpace(spc);
+  CHECK( du == Approx( pot.systemEnergy(spc.trial) - uold ) );
+  spc.geo.setVolume(V);
+  spc.geo_trial = spc.geo;
+  spc.trial = spc.p;
+  pot.setSpace(spc);
+
+  // components must follow translations and accepted volume moves
+  Tmjson jt = { {"salt", { {"peratom",true} } } };
+  Tmjson jv = { {"dp",0.5}, {"pressure",10.0} };
+  Move::AtomicTranslation<Tspace> mt(pot, spc, jt);
+  Move::Isobaric<Tspace> mv(pot, spc, jv);
+  double u0 = pot.systemEnergy(spc.p), sum = 0;
+  for (int n=0; n<20; n++) {
+    sum += mv.move();
+    for (int k=0; k<5; k++)
+      sum += mt.move();
+  }
+  CHECK( mv.getAcceptance() > 0 );
+  CHECK( u0 + sum == Approx( pot.systemEnergy(spc.p) ) );
+
+  // an empty change, e.g. from swapped charges, must invalidate the components
+  std::swap(spc.p[0].charge, spc.p[7].charge);
+  spc.trial = spc.p;
+  pot.updateChange(Tspace::Change());
+  pot.update(true);
+  V = spc.geo.getVolume();
+  spc.geo_trial = spc.geo;
+  spc.geo_trial.setVolume(1.1*V);
+  CHECK( pot.scaledEnergyChange(s, du) );
+  uold = pot.systemEnergy(spc.p);
+  for (auto &a : spc.trial)
+    a = a * s;
+  spc.geo = spc.geo_trial;
+  pot.setSpace(spc);
+  CHECK( du == Approx( pot.systemEnergy(spc.trial) - uold ) );
+  spc.groupList().clear();
+}
+
+/*
+ * Evaluate box deformations under the trial geometry and compare with
+ * energies calculated after rescaling the actual geometry
+ */
+template<template<class,class> class Tenergy>
+void testTrialGeometry()
+{
+  typedef Space<Geometry::Cuboid,PointParticle> Tspace;
+  typedef Potential::CutShift<Potential::Coulomb,false> Tpairpot;
+  InputMap in("unittests.json");
+  in["energy"]["nonbonded"]["cutoff"] = 4.0;
+  in["system"]["geometry"]["length"] = 40.0;
+  Tspace spc(in);
+  auto m = spc.molList().find("salt");
+  for (int i=0; i<100; i++)
+    spc.insert( m->id, m->getRandomConformation() );
+  for (size_t i=0; i<spc.p.size(); i++) {
+    spc.geo.randompos( spc.p[i] );
+    spc.p[i].charge = (i%2==0) ? 1 : -1;
+  }
+  spc.trial = spc.p;
+
+  Tenergy<Tspace,Tpairpot> pot(in);
+  pot.setSpace(spc);
+
+  // stretch along z at constant volume
+  Point len = spc.geo.len, s(0.9, 0.9, 1/(0.9*0.9));
+  Tspace::Change c;
+  c.geometryChange = true;
+  for (int i=0; i<(int)spc.p.size(); i++)
+    c.mvGroup[0].push_back(i); // atomic group - list all particles
+  spc.geo_trial = spc.geo;
+  spc.geo_trial.setlen( len.cwiseProduct(s) );
+  for (auto &a : spc.trial)
+    a = a.cwiseProduct(s);
+  double uold = pot.systemEnergy(spc.p);
+  double du = Energy::energyChange(spc, pot, c);
+  CHECK( spc.geo.len == len );
+  CHECK( &pot.getGeometry() == &spc.geo );
+  CHECK( pot.systemEnergy(spc.p) == Approx(uold) );
+  auto p = spc.p;
+  spc.geo = spc.geo_trial;
+  spc.p = spc.trial;
+  pot.setSpace(spc);
+  CHECK( du == Approx( pot.systemEnergy(spc.p) - uold ) );
+
+  // rejected and accepted volume moves keep neighbour lists in sync
+  Energy::Nonbonded<Tspace,Tpairpot> ref(in);
+  for (bool acc : {false, true}) {
+    spc.geo_trial.setlen( spc.geo.len.cwiseProduct(s) );
+    for (size_t i=0; i<spc.p.size(); i++)
+      spc.trial[i] = spc.p[i].cwiseProduct(s);
+    pot.updateChange(c);
+    Energy::energyChange(spc, pot, c);
+    if (acc) {
+      spc.geo = spc.geo_trial;
+      spc.p = spc.trial;
+    } else {
+      spc.geo_trial = spc.geo;
+      spc.trial = spc.p;
+    }
+    pot.setSpace(spc);
+    pot.update(acc);
+    ref.setSpace(spc);
+    CHECK( pot.systemEnergy(spc.p) == Approx(ref.systemEnergy(spc.p)) );
+    CHECK( pot.systemEnergy(spc.trial) == Approx(ref.systemEnergy(spc.trial)) );
+  }
+  spc.geo.setlen(len);
+  spc.geo_trial = spc.geo;
+  spc.p = spc.trial = p;
+  spc.groupList().clear();
+}
+
+TEST_CASE("Trial geometry", "Energy changes evaluated under the trial geometry")
+{
+  testTrialGeometry<Energy::Nonbonded>();
+  testTrialGeometry<Energy::NonbondedCellList>();
+  testTrialGeometry<Energy::NonbondedVerlet>();
+}
+
+TEST_CASE("Trial volume screening", "Counter ion screening follows the trial volume")
+{
+  typedef Space<Geometry::Cuboid,PointParticle> Tspace;
+  InputMap in("unittests.json");
+  in["energy"]["nonbonded"]["ionicstrength"] = 0.01;
+  in["energy"]["nonbonded"]["countervalency"] = -1.0;
+  in["system"]["geometry"]["length"] = 40.0;
+  Tspace spc(in);
+  auto m = spc.molList().find("salt");
+  for (int i=0; i<100; i++)
+    spc.insert( m->id, m->getRandomConformation() );
+  for (size_t i=0; i<spc.p.size(); i++) {
+    spc.geo.randompos( spc.p[i] );
+    spc.p[i].charge = (i%3==0) ? -1 : 1; // net charge neutralised by counter ions
+  }
+  spc.trial = spc.p;
+
+  Energy::Nonbonded<Tspace,Potential::DebyeHuckel> pot(in);
+  pot.setSpace(spc);
+  double D = pot.pairpot.debyeLength();
+
+  Tspace::Change c;
+  c.geometryChange = true;
+  c.dV = 0.5*spc.geo.getVolume();
+  for (int i=0; i<(int)spc.p.size(); i++)
+    c.mvGroup[0].push_back(i);
+  spc.geo_trial = spc.geo;
+  spc.geo_trial.setVolume( spc.geo.getVolume() + c.dV );
+  double s = spc.geo_trial.len.x() / spc.geo.len.x();
+  for (auto &a : spc.trial)
+    a = a*s;
+  double uold = pot.systemEnergy(spc.p);
+  double du = Energy::energyChange(spc, pot, c);
+  CHECK( pot.pairpot.debyeLength() == Approx(D) );
+  auto geo = spc.geo;
+  auto p = spc.p;
+  spc.geo = spc.geo_trial;
+  spc.p = spc.trial;
+  pot.setSpace(spc);
+  CHECK( pot.pairpot.debyeLength() > D );
+  CHECK( du == Approx( pot.systemEnergy(spc.p) - uold ) );
+  spc.geo = spc.geo_trial = geo;
+  spc.p = spc.trial = p;
+  spc.groupList().clear();
+}
+
+/*
+ * Run batched atomic translations and check that the returned energy
+ * changes add up to the system energy difference
+ */
+template<class Tgeometry, template<class,class> class Tenergy>
+void testBatchMove()
+{
+  typedef Space<Tgeometry,PointParticle> Tspace;
+  typedef Potential::CutShift<Potential::Coulomb,false> Tpairpot;
+  InputMap in("unittests.json");
+  in["energy"]["nonbonded"]["cutoff"] = 4.0;
+  in["system"]["geometry"]["length"] = 40.0;
+  in["system"]["geometry"]["radius"] = 20.0;
+  Tspace spc(in);
+  auto m = spc.molList().find("salt");
+  for (int i=0; i<100; i++)
+    spc.insert( m->id, m->getRandomConformation() );
+  for (size_t i=0; i<spc.p.size(); i++) {
+    spc.geo.randompos( spc.p[i] );
+    spc.p[i].charge = (i%2==0) ? 1 : -1;
+  }
+  spc.trial = spc.p;
+
+  Tenergy<Tspace,Tpairpot> pot(in);
+  Tmjson jshort = { {"batch_size",16}, {"batch_cutoff",3.0} };
+  CHECK_THROWS( Move::AtomicTranslation<Tspace>(pot, spc, jshort) ); // shorter than pair potential
+  Tmjson j = { {"batch_size",16}, {"batch_cutoff",4.0}, {"salt", { {"peratom",true} } } };
+  Move::AtomicTranslation<Tspace> mv(pot, spc, j);
+  std::vector<double> dp;
+  for (auto &a : atom) {
+    dp.push_back(a.dp);
+    a.dp = 4.0; // rarely leave open containers
+  }
+  double u0 = Energy::systemEnergy(spc,pot,spc.p), du = 0;
+  for (int n=0; n<5; n++)
+    du += mv.move();
+  for (int n=0; n<5; n++)
+    du += mv.sweep(); // checkerboard
+  CHECK( spc.p == spc.trial );
+  CHECK( mv.getAcceptance() > 0.1 );
+  CHECK( u0 + du == Approx( Energy::systemEnergy(spc,pot,spc.p) ) );
+  for (size_t i=0; i<dp.size(); i++)
+    atom[i].dp = dp[i];
+  spc.groupList().clear();
+}
+
+TEST_CASE("Batched moves", "Parallel evaluation of independent atomic translations and checkerboard sweeps")
+{
+  testBatchMove<Geometry::Cuboid, Energy::Nonbonded>();
+  testBatchMove<Geometry::Cuboid, Energy::NonbondedCellList>();
+  testBatchMove<Geometry::Sphere, Energy::Nonbonded>(); // open boundaries
+}
+
+TEST_CASE("Displacement tuning", "Equilibration tuning of move displacement parameters")
+{
+  typedef Space<Geometry::Cuboid,PointParticle> Tspace;
+  InputMap in("unittests.json");
+  in["system"]["geometry"]["length"] = 40.0;
+  Tspace spc(in);
+  auto m = spc.molList().find("salt");
+  for (int i=0; i<20; i++)
+    spc.insert( m->id, m->getRandomConformation() );
+  for (auto &a : spc.p)
+    spc.geo.randompos(a);
+  spc.trial = spc.p;
+
+  Energy::Nonbonded<Tspace,Potential::HardSphere> pot(in);
+  Tmjson j = { {"salt", { {"peratom",true} } } };
+  Move::AtomicTranslation<Tspace> mv(pot, spc, j);
+  int id = spc.p[0].id;
+  double dp = atom[id].dp;
+  atom[id].dp = 0.01; // far too small in a dilute system
+  mv.setTuning(2000, 100);
+  for (int n=0; n<2000; n++)
+    mv.move();
+  double tuned = atom[id].dp;
+  CHECK( tuned > 0.1 );
+  for (int n=0; n<20; n++)
+    mv.move();
+  CHECK( atom[id].dp == tuned ); // frozen after tuning
+  CHECK( mv.json()[mv.json().begin().key()]["tuned"][atom[id].name + " dp"] == tuned );
+  atom[id].dp = dp;
+  spc.groupList().clear();
+}
+
+/*
+ * Cluster moves with access to the cluster found in the last trial move
+ * and to the direct search over all candidate particles or molecules
+ */
+template<class Tspace>
+struct TestTranslateRotateCluster : public Move::TranslateRotateCluster<Tspace>
+{
+  typedef Move::TranslateRotateCluster<Tspace> base;
+  TestTranslateRotateCluster( Energy::Energybase<Tspace> &e, Tspace &s, Tmjson &j ) : base(e,s,j) {}
+
+  void compare( int molid )
+  {
+    this->currentMolId = molid;
+    base::_trialMove();
+    double du = base::_energyChange();
+    std::vector<int> direct;
+    for (auto i : *this->gmobile)
+      if ( this->ClusterProbability(this->spc->p, i) > 0 )
+        direct.push_back(i);
+    auto c = this->cindex;
+    std::sort(c.begin(), c.end());
+    CHECK( c == direct );
+    this->rcluster = 0; // bias from all mobile particles
+    CHECK( base::_energyChange() == du );
+    base::_rejectMove();
+  }
+};
+
+template<class Tspace>
+struct TestClusterMove : public Move::ClusterMove<Tspace>
+{
+  typedef Move::ClusterMove<Tspace> base;
+  TestClusterMove( Energy::Energybase<Tspace> &e, Tspace &s, Tmjson &j ) : base(e,s,j) {}
+
+  void compare( int molid )
+  {
+    this->currentMolId = molid;
+    base::_trialMove();
+    auto c = this->cindex;
+    this->rcluster = 0; // search all molecules
+    this->cindex.clear();
+    this->cindex.push_back(this->igroup);
+    this->getClusterAroundMolecule(this->igroup);
+    auto direct = this->cindex;
+    this->cindex = c;
+    std::sort(c.begin(), c.end());
+    std::sort(direct.begin(), direct.end());
+    CHECK( c == direct );
+    base::_rejectMove();
+  }
+};
+
+TEST_CASE("Cluster moves", "Compare clusters found using cell lists with direct search")
+{
+  typedef Space<Geometry::Cuboid,PointParticle> Tspace;
+  InputMap in("unittests.json");
+  in["system"]["geometry"]["length"] = 60.0;
+  Tspace spc(in);
+  auto sq = spc.molList().find("square");
+  auto salt = spc.molList().find("salt");
+  for (int i=0; i<20; i++)
+    spc.insert( sq->id, sq->getRandomConformation(spc.geo, spc.p) );
+  for (int i=0; i<100; i++)
+    spc.insert( salt->id, salt->getRandomConformation() );
+  for (auto g : spc.groupList())
+    if (g->isAtomic())
+      for (auto i : *g) {
+        spc.geo.randompos(spc.p[i]);
+        spc.p[i].charge = (i%2==0) ? 1 : -1;
+      }
+  spc.trial = spc.p;
+
+  Energy::Nonbonded<Tspace,Potential::Coulomb> pot(in);
+  Tmjson jt = { {"center_rotation",false},
+    {"square", { {"clustergroup","salt"}, {"threshold",3.0}, {"dp",10.0}, {"dprot",1.0} } } };
+  Tmjson jc = { {"center_rotation",false}, {"cluster_probability",1.0}, {"staticmol",{"salt"}},
+    {"square", { {"threshold",2.0}, {"dp",10.0}, {"dprot",1.0} } } };
+  TestTranslateRotateCluster<Tspace> mt(pot, spc, jt);
+  Tmjson ja = { {"salt", { {"peratom",true} } } };
+  TestClusterMove<Tspace> mc(pot, spc, jc);
+  Move::AtomicTranslation<Tspace> ma(pot, spc, ja);
+  for (int n=0; n<20; n++) {
+    mt.compare(sq->id);
+    mc.compare(sq->id);
+    mt.move(); // cell lists follow changes via Space::changeLog()
+    mc.move();
+    ma.move();
+  }
+  CHECK( spc.p == spc.trial );
+  spc.groupList().clear();
+}
+
+/*
+ * Polymer move with access to the trial move and energy change
+ */
+template<class Tmove>
+struct TestChainMove : public Tmove
+{
+  template<class Tenergy, class Tspace>
+  TestChainMove( Tenergy &e, Tspace &s, Tmjson &j ) : Tmove(e,s,j) {}
+
+  void compare( int molid )
+  {
+    auto &spc = *this->spc;
+    this->currentMolId = molid;
+    this->trialMove();
+    double du = Energy::systemEnergy(spc,*this->pot,spc.trial) - Energy::systemEnergy(spc,*this->pot,spc.p);
+    CHECK( this->energyChange() == Approx(du) );
+    this->rejectMove();
+    this->change.clear();
+  }
+};
+
+/*
+ * Compare energy changes of polymer moves with the system energy difference
+ * for uniform chains and for chains of alternating charges and bond lengths
+ */
+template<template<class,class> class Tnonbonded>
+void testChainMoves()
+{
+  typedef Space<Geometry::Cuboid,PointParticle> Tspace;
+  InputMap in("unittests.json");
+  in["system"]["geometry"]["length"] = 60.0;
+  in["energy"]["nonbonded"]["epsr"] = 80.0;
+  in["moleculelist"]["chain"] = { {"atoms","MM"} };
+  Tspace spc(in);
+  int molid = spc.molList().find("chain")->id;
+  spc.p.resize(70);
+  for (size_t i=0; i<spc.p.size(); i++) {
+    spc.p[i].id = atom[i<20 ? "MM" : (i%2==0 ? "Na" : "Cl")].id;
+    spc.p[i].charge = (i<20 || i%2==0) ? 1 : -1;
+    if (i==0 || i>=20)
+      spc.geo.randompos( spc.p[i] );
+    else {
+      Point u;
+      u.ranunit(slump);
+      spc.p[i] = spc.p[i-1];
+      spc.p[i].translate( spc.geo, u*4.0 );
+    }
+  }
+  spc.trial = spc.p;
+  Group chain(0,19), salt(20,69);
+  chain.setMolSize(20);
+  chain.molId = molid;
+  chain.name = "chain";
+  salt.setMolSize(1);
+  salt.molId = spc.molList().find("salt")->id;
+  spc.groupList() = {&chain, &salt};
+  spc.initTracker();
+
+  auto pot = Tnonbonded<Tspace,Potential::Coulomb>(in) + Energy::Bonded<Tspace>();
+  auto bonds = [&](double req) { // alternating 4 and `req` angstrom
+    pot.second.clear();
+    for (int i=0; i<19; i++)
+      pot.second.add(i, i+1, Potential::Harmonic(0.5, (i%2==0) ? 4.0 : req));
+  };
+  bonds(4.0);
+  pot.setSpace(spc);
+
+  Tmjson jc = { {"chain", { {"dp",3.0}, {"minlen",1}, {"maxlen",10} } } };
+  Tmjson jp = { {"chain", { {"dp",3.0}, {"minlen",1}, {"maxlen",19} } } };
+  Tmjson jr = { {"chain", { {"bondlength",-1.0} } } };
+  TestChainMove<Move::CrankShaft<Tspace>> mc(pot, spc, jc);
+  TestChainMove<Move::Pivot<Tspace>> mp(pot, spc, jp);
+  TestChainMove<Move::Reptation<Tspace>> mr(pot, spc, jr);
+  for (int uniform=1; uniform>=0; uniform--) {
+    if (!uniform) {
+      for (auto i : chain)
+        spc.p[i].charge = spc.trial[i].charge = (i%2==0) ? 1 : -1;
+      bonds(5.0);
+    }
+    for (int n=0; n<20; n++) {
+      mc.compare(molid);
+      mp.compare(molid);
+      mr.compare(molid);
+      mc.move();
+      mp.move();
+      mr.move();
+    }
+  }
+  CHECK( spc.p == spc.trial );
+  pot.second.clear(); // no bond list output
+  spc.groupList().clear();
+}
+
+TEST_CASE("Chain moves", "Compare segment energy changes of polymer moves with system energy difference")
+{
+  testChainMoves<Energy::Nonbonded>();
+  testChainMoves<Energy::NonbondedCutg2g>(); // not pairwise; whole chain is evaluated
 }
 
 TEST_CASE("Groups", "Check group range and size properties")
@@ -248,6 +1253,50 @@ TEST_CASE("Space", "Space tests")
   //Tspace spc(in);
   //PointParticle a;
   //spc.insert(a);
+
+  typedef Space<Geometry::Cuboid, PointParticle> Tspace;
+  InputMap in("unittests.json");
+  Tspace spc(in);
+  spc.p.resize(10);
+  spc.trial = spc.p;
+  Group g(0,9);
+  spc.groupList().push_back(&g);
+
+  SECTION("particle arrays") {
+    spc.enableArrays();
+    spc.trial[3].x() = 1.5;
+    spc.trial[3].charge = -1;
+    Tspace::Change c;
+    c.mvGroup[0] = {3};
+    spc.syncArrays(c);
+    CHECK( spc.arrays(spc.trial).x[3] == Approx(1.5) );
+    CHECK( spc.arrays(spc.trial).charge[3] == Approx(-1) );
+    CHECK( spc.arrays(spc.p).x[3] == Approx(spc.p[3].x()) );
+    spc.applyChange(c);
+    CHECK( spc.arrays(spc.p).x[3] == Approx(1.5) );
+    spc.p.resize(12);
+    CHECK( spc.arrays(spc.p).size() == 12 );
+  }
+
+  SECTION("group lookup") {
+    CHECK_THROWS( spc.findGroup(4) ); // groupList() modified directly...
+    spc.updateGroupIndex();               // ...so the table must be rebuilt
+    CHECK( spc.findGroup(4) == &g );
+    CHECK( spc.findGroup(10) == nullptr );
+    spc.initTracker();
+    auto m = spc.molList().find("square");
+    Group *sq = spc.insert( m->id, m->getRandomConformation(spc.geo, spc.p) );
+    CHECK( spc.findGroup(10) == sq );
+    CHECK( spc.findGroup(13) == sq );
+    CHECK( spc.findIndex(sq) == 1 );
+    spc.erase(0);
+    CHECK( spc.findGroup(8) == &g );
+    CHECK( spc.findGroup(9) == sq );
+    spc.eraseGroup(1);
+    CHECK( spc.findGroup(9) == nullptr );
+    CHECK( spc.findIndex(&g) == 0 );
+  }
+  spc.groupList().clear();
 }
 
 TEST_CASE("Geometries", "Geometry tests")
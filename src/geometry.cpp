@@ -32,6 +32,19 @@ namespace Faunus
         assert(!"Scaling function unimplemented for this geometry");
     }
 
+    /**
+     * Scales a test point and returns the common factor if all coordinates
+     * change by the same amount, i.e. if all distances are scaled
+     * uniformly. Otherwise zero is returned.
+     */
+    double Geometrybase::isotropicScale( Point &s, const double xyz, const double xy ) const
+    {
+        Point a(1, 2, 3), b = a;
+        scale(b, s, xyz, xy);
+        double f = b.x();
+        return ((b - f * a).norm() < 1e-10 * b.norm()) ? f : 0;
+    }
+
     Cuboid Geometrybase::inscribe() const
     {
         assert(!"Inscribe function not implemented for this geometry");